@@ -34,14 +34,45 @@ const char *gengetopt_args_info_versiontext = "";
 const char *gengetopt_args_info_description = "";
 
 const char *gengetopt_args_info_help[] = {
-  "  -h, --help                Print help and exit",
-  "  -V, --version             Print version and exit",
-  "  -w, --writemethod=STRING  ADIOS write method  (default=`POSIX')",
-  "      --wparams=STRING      write method params\n                              (default=`local-fs=1;have_metadata_file=1')",
-  "  -n, --len=LONG            array length  (default=`1000')",
-  "      --nstep=INT           number of time steps  (default=`1')",
-  "      --sleep=INT           interval time  (default=`3')",
-  "      --append              append  (default=off)",
+  "  -h, --help                 Print help and exit",
+  "  -V, --version              Print version and exit",
+  "  -w, --writemethod=STRING   ADIOS write method  (default=`POSIX')",
+  "      --wparams=STRING       write method params\n                               (default=`local-fs=1;have_metadata_file=1')",
+  "      --buffer-mb=INT        maximum ADIOS buffer per process in MB (0: the\n                               ADIOS default)  (default=`0')",
+  "      --buffer-alloc=STRING  when ADIOS allocates its buffer: default (left to\n                               ADIOS), now (at start-up) or later (at the first\n                               open); needs --buffer-mb, no effect since ADIOS\n                               1.10  (default=`default')",
+  "  -n, --len=LONG             array length  (default=`1000')",
+  "      --imbalance=STRING     block sizes over ranks: uniform, linear, zipf,\n                               heavy (every 8th rank) or zero (every 4th rank\n                               empty)  (default=`uniform')",
+  "      --skew=DOUBLE          imbalance strength: largest/smallest - 1 for\n                               linear and heavy, exponent for zipf  (default=`1')",
+  "      --placement=STRING     aggregator placement for num_aggregators of the\n                               write method (MPI_AGGREGATE): rank (as launched),\n                               spread (round-robin over nodes), pack (fewest\n                               nodes), or a file with one line per aggregator:\n                               its rank, then its members  (default=`rank')",
+  "      --ranks-per-node=INT   treat every N consecutive ranks as a node, to\n                               emulate nodes on one (0: shared-memory nodes)\n                               (default=`0')",
+  "      --global-len=LONG      global array length split over the processes, the\n                               remainder to the low ranks (strong scaling;\n                               overrides len, and sweep and --type lengths become\n                               global)",
+  "      --nstep=INT            number of time steps  (default=`1')",
+  "      --sleep=INT            interval time  (default=`3')",
+  "      --compute=STRING       compute phase of --sleep seconds between steps:\n                               sleep, stream (memory-bound triad), flops\n                               (compute-bound), or halo (neighbour exchange over\n                               MPI)  (default=`sleep')",
+  "      --compute-mb=INT       working set of the stream and halo kernels per\n                               process in MB  (default=`64')",
+  "      --halo-kb=INT          halo sent to each neighbour per iteration of the\n                               halo kernel in KB  (default=`64')",
+  "      --append               append  (default=off)",
+  "      --pipeline=INT         number of step buffers for overlapped writes on an\n                               I/O thread (<2: serial)  (default=`0')",
+  "      --ballast-mb=LONG      memory ballast per process in MB  (default=`512')",
+  "      --ballast-frac=DOUBLE  memory ballast as a fraction of node memory,\n                               shared by the processes of a node (overrides\n                               ballast-mb)  (default=`0')",
+  "      --touch=STRING         ballast touch pattern: none, memset, page or\n                               random  (default=`memset')",
+  "      --thp                  use transparent huge pages for the ballast\n                               (default=off)",
+  "      --retouch=INT          touch the ballast again every N steps (0: never)\n                               (default=`0')",
+  "      --results=STRING       write per-step statistics over ranks and the run\n                               configuration to FILE (JSON, or CSV for a .csv\n                               name)",
+  "      --drain=STRING         burst buffer: FILE is on node-local storage and a\n                               thread per node copies each closed step to this\n                               directory",
+  "      --trace=STRING         write a per-rank timeline of the run to FILE\n                               (Chrome trace JSON, for chrome://tracing or\n                               Perfetto)",
+  "      --stragglers           report per-node bandwidth, the slowest node and\n                               rank of each phase, a histogram of rank times and\n                               persistent stragglers  (default=off)",
+  "      --quiet                do not print per-rank timing lines  (default=off)",
+  "      --sweep=STRING         run every configuration of FILE in this job, one\n                               \"LEN [METHOD [PARAMS [NVARS [IMBALANCE\n                               [PLACEMENT]]]]]\" per line",
+  "      --checksum             also write a checksum of each block for reader\n                               --checksum  (default=off)",
+  "      --pattern=STRING       data pattern: ramp, constant, random, smooth or\n                               sparse  (default=`ramp')",
+  "      --fill-threads=INT     threads generating each step  (default=`1')",
+  "      --transform=STRING     ADIOS transform of x, e.g. zlib:9, bzip2, szip,\n                               sz:abs=0.001 or zfp:accuracy=0.001  (default=`')",
+  "      --nvars=INT            number of extra arrays v0..vN-1 written next to x\n                               (default=`0')",
+  "      --type=STRING          types of the extra arrays, cycled: comma-separated\n                               TYPE[:LEN] with TYPE byte, short, int, long,\n                               float, double, complex or dcomplex (LEN: len)\n                               (default=`double')",
+  "      --autotune             search num_aggregators and num_ost of the write\n                               method (MPI_AGGREGATE) for the best bandwidth,\n                               nstep steps per candidate  (default=off)",
+  "      --tune-max-ost=INT     largest num_ost the auto-tuner tries\n                               (default=`16')",
+  "      --durable              fsync the output files before stopping the clock\n                               of each step, reporting durable next to buffered\n                               bandwidth  (default=off)",
     0
 };
 
@@ -50,6 +81,7 @@ typedef enum {ARG_NO
   , ARG_STRING
   , ARG_INT
   , ARG_LONG
+  , ARG_DOUBLE
 } cmdline_parser_arg_type;
 
 static
@@ -72,10 +104,41 @@ void clear_given (struct gengetopt_args_info *args_info)
   args_info->version_given = 0 ;
   args_info->writemethod_given = 0 ;
   args_info->wparams_given = 0 ;
+  args_info->buffer_mb_given = 0 ;
+  args_info->buffer_alloc_given = 0 ;
   args_info->len_given = 0 ;
+  args_info->imbalance_given = 0 ;
+  args_info->skew_given = 0 ;
+  args_info->placement_given = 0 ;
+  args_info->ranks_per_node_given = 0 ;
+  args_info->global_len_given = 0 ;
   args_info->nstep_given = 0 ;
   args_info->sleep_given = 0 ;
+  args_info->compute_given = 0 ;
+  args_info->compute_mb_given = 0 ;
+  args_info->halo_kb_given = 0 ;
   args_info->append_given = 0 ;
+  args_info->pipeline_given = 0 ;
+  args_info->ballast_mb_given = 0 ;
+  args_info->ballast_frac_given = 0 ;
+  args_info->touch_given = 0 ;
+  args_info->thp_given = 0 ;
+  args_info->retouch_given = 0 ;
+  args_info->results_given = 0 ;
+  args_info->drain_given = 0 ;
+  args_info->trace_given = 0 ;
+  args_info->stragglers_given = 0 ;
+  args_info->quiet_given = 0 ;
+  args_info->sweep_given = 0 ;
+  args_info->checksum_given = 0 ;
+  args_info->pattern_given = 0 ;
+  args_info->fill_threads_given = 0 ;
+  args_info->transform_given = 0 ;
+  args_info->nvars_given = 0 ;
+  args_info->type_given = 0 ;
+  args_info->autotune_given = 0 ;
+  args_info->tune_max_ost_given = 0 ;
+  args_info->durable_given = 0 ;
 }
 
 static
@@ -86,13 +149,68 @@ void clear_args (struct gengetopt_args_info *args_info)
   args_info->writemethod_orig = NULL;
   args_info->wparams_arg = gengetopt_strdup ("local-fs=1;have_metadata_file=1");
   args_info->wparams_orig = NULL;
+  args_info->buffer_mb_arg = 0;
+  args_info->buffer_mb_orig = NULL;
+  args_info->buffer_alloc_arg = gengetopt_strdup ("default");
+  args_info->buffer_alloc_orig = NULL;
   args_info->len_arg = 1000;
   args_info->len_orig = NULL;
+  args_info->imbalance_arg = gengetopt_strdup ("uniform");
+  args_info->imbalance_orig = NULL;
+  args_info->skew_arg = 1;
+  args_info->skew_orig = NULL;
+  args_info->placement_arg = gengetopt_strdup ("rank");
+  args_info->placement_orig = NULL;
+  args_info->ranks_per_node_arg = 0;
+  args_info->ranks_per_node_orig = NULL;
+  args_info->global_len_orig = NULL;
   args_info->nstep_arg = 1;
   args_info->nstep_orig = NULL;
   args_info->sleep_arg = 3;
   args_info->sleep_orig = NULL;
+  args_info->compute_arg = gengetopt_strdup ("sleep");
+  args_info->compute_orig = NULL;
+  args_info->compute_mb_arg = 64;
+  args_info->compute_mb_orig = NULL;
+  args_info->halo_kb_arg = 64;
+  args_info->halo_kb_orig = NULL;
   args_info->append_flag = 0;
+  args_info->pipeline_arg = 0;
+  args_info->pipeline_orig = NULL;
+  args_info->ballast_mb_arg = 512;
+  args_info->ballast_mb_orig = NULL;
+  args_info->ballast_frac_arg = 0;
+  args_info->ballast_frac_orig = NULL;
+  args_info->touch_arg = gengetopt_strdup ("memset");
+  args_info->touch_orig = NULL;
+  args_info->thp_flag = 0;
+  args_info->retouch_arg = 0;
+  args_info->retouch_orig = NULL;
+  args_info->results_arg = NULL;
+  args_info->results_orig = NULL;
+  args_info->drain_arg = NULL;
+  args_info->drain_orig = NULL;
+  args_info->trace_arg = NULL;
+  args_info->trace_orig = NULL;
+  args_info->stragglers_flag = 0;
+  args_info->quiet_flag = 0;
+  args_info->sweep_arg = NULL;
+  args_info->sweep_orig = NULL;
+  args_info->checksum_flag = 0;
+  args_info->pattern_arg = gengetopt_strdup ("ramp");
+  args_info->pattern_orig = NULL;
+  args_info->fill_threads_arg = 1;
+  args_info->fill_threads_orig = NULL;
+  args_info->transform_arg = gengetopt_strdup ("");
+  args_info->transform_orig = NULL;
+  args_info->nvars_arg = 0;
+  args_info->nvars_orig = NULL;
+  args_info->type_arg = gengetopt_strdup ("double");
+  args_info->type_orig = NULL;
+  args_info->autotune_flag = 0;
+  args_info->tune_max_ost_arg = 16;
+  args_info->tune_max_ost_orig = NULL;
+  args_info->durable_flag = 0;
   
 }
 
@@ -105,10 +223,41 @@ void init_args_info(struct gengetopt_args_info *args_info)
   args_info->version_help = gengetopt_args_info_help[1] ;
   args_info->writemethod_help = gengetopt_args_info_help[2] ;
   args_info->wparams_help = gengetopt_args_info_help[3] ;
-  args_info->len_help = gengetopt_args_info_help[4] ;
-  args_info->nstep_help = gengetopt_args_info_help[5] ;
-  args_info->sleep_help = gengetopt_args_info_help[6] ;
-  args_info->append_help = gengetopt_args_info_help[7] ;
+  args_info->buffer_mb_help = gengetopt_args_info_help[4] ;
+  args_info->buffer_alloc_help = gengetopt_args_info_help[5] ;
+  args_info->len_help = gengetopt_args_info_help[6] ;
+  args_info->imbalance_help = gengetopt_args_info_help[7] ;
+  args_info->skew_help = gengetopt_args_info_help[8] ;
+  args_info->placement_help = gengetopt_args_info_help[9] ;
+  args_info->ranks_per_node_help = gengetopt_args_info_help[10] ;
+  args_info->global_len_help = gengetopt_args_info_help[11] ;
+  args_info->nstep_help = gengetopt_args_info_help[12] ;
+  args_info->sleep_help = gengetopt_args_info_help[13] ;
+  args_info->compute_help = gengetopt_args_info_help[14] ;
+  args_info->compute_mb_help = gengetopt_args_info_help[15] ;
+  args_info->halo_kb_help = gengetopt_args_info_help[16] ;
+  args_info->append_help = gengetopt_args_info_help[17] ;
+  args_info->pipeline_help = gengetopt_args_info_help[18] ;
+  args_info->ballast_mb_help = gengetopt_args_info_help[19] ;
+  args_info->ballast_frac_help = gengetopt_args_info_help[20] ;
+  args_info->touch_help = gengetopt_args_info_help[21] ;
+  args_info->thp_help = gengetopt_args_info_help[22] ;
+  args_info->retouch_help = gengetopt_args_info_help[23] ;
+  args_info->results_help = gengetopt_args_info_help[24] ;
+  args_info->drain_help = gengetopt_args_info_help[25] ;
+  args_info->trace_help = gengetopt_args_info_help[26] ;
+  args_info->stragglers_help = gengetopt_args_info_help[27] ;
+  args_info->quiet_help = gengetopt_args_info_help[28] ;
+  args_info->sweep_help = gengetopt_args_info_help[29] ;
+  args_info->checksum_help = gengetopt_args_info_help[30] ;
+  args_info->pattern_help = gengetopt_args_info_help[31] ;
+  args_info->fill_threads_help = gengetopt_args_info_help[32] ;
+  args_info->transform_help = gengetopt_args_info_help[33] ;
+  args_info->nvars_help = gengetopt_args_info_help[34] ;
+  args_info->type_help = gengetopt_args_info_help[35] ;
+  args_info->autotune_help = gengetopt_args_info_help[36] ;
+  args_info->tune_max_ost_help = gengetopt_args_info_help[37] ;
+  args_info->durable_help = gengetopt_args_info_help[38] ;
   
 }
 
@@ -199,9 +348,46 @@ cmdline_parser_release (struct gengetopt_args_info *args_info)
   free_string_field (&(args_info->writemethod_orig));
   free_string_field (&(args_info->wparams_arg));
   free_string_field (&(args_info->wparams_orig));
+  free_string_field (&(args_info->buffer_mb_orig));
+  free_string_field (&(args_info->buffer_alloc_arg));
+  free_string_field (&(args_info->buffer_alloc_orig));
   free_string_field (&(args_info->len_orig));
+  free_string_field (&(args_info->imbalance_arg));
+  free_string_field (&(args_info->imbalance_orig));
+  free_string_field (&(args_info->skew_orig));
+  free_string_field (&(args_info->placement_arg));
+  free_string_field (&(args_info->placement_orig));
+  free_string_field (&(args_info->ranks_per_node_orig));
+  free_string_field (&(args_info->global_len_orig));
   free_string_field (&(args_info->nstep_orig));
   free_string_field (&(args_info->sleep_orig));
+  free_string_field (&(args_info->compute_arg));
+  free_string_field (&(args_info->compute_orig));
+  free_string_field (&(args_info->compute_mb_orig));
+  free_string_field (&(args_info->halo_kb_orig));
+  free_string_field (&(args_info->pipeline_orig));
+  free_string_field (&(args_info->ballast_mb_orig));
+  free_string_field (&(args_info->ballast_frac_orig));
+  free_string_field (&(args_info->touch_arg));
+  free_string_field (&(args_info->touch_orig));
+  free_string_field (&(args_info->retouch_orig));
+  free_string_field (&(args_info->results_arg));
+  free_string_field (&(args_info->results_orig));
+  free_string_field (&(args_info->drain_arg));
+  free_string_field (&(args_info->drain_orig));
+  free_string_field (&(args_info->trace_arg));
+  free_string_field (&(args_info->trace_orig));
+  free_string_field (&(args_info->sweep_arg));
+  free_string_field (&(args_info->sweep_orig));
+  free_string_field (&(args_info->pattern_arg));
+  free_string_field (&(args_info->pattern_orig));
+  free_string_field (&(args_info->fill_threads_orig));
+  free_string_field (&(args_info->transform_arg));
+  free_string_field (&(args_info->transform_orig));
+  free_string_field (&(args_info->nvars_orig));
+  free_string_field (&(args_info->type_arg));
+  free_string_field (&(args_info->type_orig));
+  free_string_field (&(args_info->tune_max_ost_orig));
   
   
   for (i = 0; i < args_info->inputs_num; ++i)
@@ -245,14 +431,76 @@ cmdline_parser_dump(FILE *outfile, struct gengetopt_args_info *args_info)
     write_into_file(outfile, "writemethod", args_info->writemethod_orig, 0);
   if (args_info->wparams_given)
     write_into_file(outfile, "wparams", args_info->wparams_orig, 0);
+  if (args_info->buffer_mb_given)
+    write_into_file(outfile, "buffer-mb", args_info->buffer_mb_orig, 0);
+  if (args_info->buffer_alloc_given)
+    write_into_file(outfile, "buffer-alloc", args_info->buffer_alloc_orig, 0);
   if (args_info->len_given)
     write_into_file(outfile, "len", args_info->len_orig, 0);
+  if (args_info->imbalance_given)
+    write_into_file(outfile, "imbalance", args_info->imbalance_orig, 0);
+  if (args_info->skew_given)
+    write_into_file(outfile, "skew", args_info->skew_orig, 0);
+  if (args_info->placement_given)
+    write_into_file(outfile, "placement", args_info->placement_orig, 0);
+  if (args_info->ranks_per_node_given)
+    write_into_file(outfile, "ranks-per-node", args_info->ranks_per_node_orig, 0);
+  if (args_info->global_len_given)
+    write_into_file(outfile, "global-len", args_info->global_len_orig, 0);
   if (args_info->nstep_given)
     write_into_file(outfile, "nstep", args_info->nstep_orig, 0);
   if (args_info->sleep_given)
     write_into_file(outfile, "sleep", args_info->sleep_orig, 0);
+  if (args_info->compute_given)
+    write_into_file(outfile, "compute", args_info->compute_orig, 0);
+  if (args_info->compute_mb_given)
+    write_into_file(outfile, "compute-mb", args_info->compute_mb_orig, 0);
+  if (args_info->halo_kb_given)
+    write_into_file(outfile, "halo-kb", args_info->halo_kb_orig, 0);
   if (args_info->append_given)
     write_into_file(outfile, "append", 0, 0 );
+  if (args_info->pipeline_given)
+    write_into_file(outfile, "pipeline", args_info->pipeline_orig, 0);
+  if (args_info->ballast_mb_given)
+    write_into_file(outfile, "ballast-mb", args_info->ballast_mb_orig, 0);
+  if (args_info->ballast_frac_given)
+    write_into_file(outfile, "ballast-frac", args_info->ballast_frac_orig, 0);
+  if (args_info->touch_given)
+    write_into_file(outfile, "touch", args_info->touch_orig, 0);
+  if (args_info->thp_given)
+    write_into_file(outfile, "thp", 0, 0 );
+  if (args_info->retouch_given)
+    write_into_file(outfile, "retouch", args_info->retouch_orig, 0);
+  if (args_info->results_given)
+    write_into_file(outfile, "results", args_info->results_orig, 0);
+  if (args_info->drain_given)
+    write_into_file(outfile, "drain", args_info->drain_orig, 0);
+  if (args_info->trace_given)
+    write_into_file(outfile, "trace", args_info->trace_orig, 0);
+  if (args_info->stragglers_given)
+    write_into_file(outfile, "stragglers", 0, 0 );
+  if (args_info->quiet_given)
+    write_into_file(outfile, "quiet", 0, 0 );
+  if (args_info->sweep_given)
+    write_into_file(outfile, "sweep", args_info->sweep_orig, 0);
+  if (args_info->checksum_given)
+    write_into_file(outfile, "checksum", 0, 0 );
+  if (args_info->pattern_given)
+    write_into_file(outfile, "pattern", args_info->pattern_orig, 0);
+  if (args_info->fill_threads_given)
+    write_into_file(outfile, "fill-threads", args_info->fill_threads_orig, 0);
+  if (args_info->transform_given)
+    write_into_file(outfile, "transform", args_info->transform_orig, 0);
+  if (args_info->nvars_given)
+    write_into_file(outfile, "nvars", args_info->nvars_orig, 0);
+  if (args_info->type_given)
+    write_into_file(outfile, "type", args_info->type_orig, 0);
+  if (args_info->autotune_given)
+    write_into_file(outfile, "autotune", 0, 0 );
+  if (args_info->tune_max_ost_given)
+    write_into_file(outfile, "tune-max-ost", args_info->tune_max_ost_orig, 0);
+  if (args_info->durable_given)
+    write_into_file(outfile, "durable", 0, 0 );
   
 
   i = EXIT_SUCCESS;
@@ -428,6 +676,9 @@ int update_arg(void *field, char **orig_field,
   case ARG_LONG:
     if (val) *((long *)field) = (long)strtol (val, &stop_char, 0);
     break;
+  case ARG_DOUBLE:
+    if (val) *((double *)field) = strtod (val, &stop_char);
+    break;
   case ARG_STRING:
     if (val) {
       string_field = (char **)field;
@@ -444,6 +695,7 @@ int update_arg(void *field, char **orig_field,
   switch(arg_type) {
   case ARG_INT:
   case ARG_LONG:
+  case ARG_DOUBLE:
     if (val && !(stop_char && *stop_char == '\0')) {
       fprintf(stderr, "%s: invalid numeric value: %s\n", package_name, val);
       return 1; /* failure */
@@ -515,10 +767,41 @@ cmdline_parser_internal (
         { "version",	0, NULL, 'V' },
         { "writemethod",	1, NULL, 'w' },
         { "wparams",	1, NULL, 0 },
+        { "buffer-mb",	1, NULL, 0 },
+        { "buffer-alloc",	1, NULL, 0 },
         { "len",	1, NULL, 'n' },
+        { "imbalance",	1, NULL, 0 },
+        { "skew",	1, NULL, 0 },
+        { "placement",	1, NULL, 0 },
+        { "ranks-per-node",	1, NULL, 0 },
+        { "global-len",	1, NULL, 0 },
         { "nstep",	1, NULL, 0 },
         { "sleep",	1, NULL, 0 },
+        { "compute",	1, NULL, 0 },
+        { "compute-mb",	1, NULL, 0 },
+        { "halo-kb",	1, NULL, 0 },
         { "append",	0, NULL, 0 },
+        { "pipeline",	1, NULL, 0 },
+        { "ballast-mb",	1, NULL, 0 },
+        { "ballast-frac",	1, NULL, 0 },
+        { "touch",	1, NULL, 0 },
+        { "thp",	0, NULL, 0 },
+        { "retouch",	1, NULL, 0 },
+        { "results",	1, NULL, 0 },
+        { "drain",	1, NULL, 0 },
+        { "trace",	1, NULL, 0 },
+        { "stragglers",	0, NULL, 0 },
+        { "quiet",	0, NULL, 0 },
+        { "sweep",	1, NULL, 0 },
+        { "checksum",	0, NULL, 0 },
+        { "pattern",	1, NULL, 0 },
+        { "fill-threads",	1, NULL, 0 },
+        { "transform",	1, NULL, 0 },
+        { "nvars",	1, NULL, 0 },
+        { "type",	1, NULL, 0 },
+        { "autotune",	0, NULL, 0 },
+        { "tune-max-ost",	1, NULL, 0 },
+        { "durable",	0, NULL, 0 },
         { 0,  0, 0, 0 }
       };
 
@@ -586,6 +869,104 @@ cmdline_parser_internal (
                 additional_error))
               goto failure;
           
+          }
+          /* maximum ADIOS buffer per process in MB (0: the ADIOS default).  */
+          else if (strcmp (long_options[option_index].name, "buffer-mb") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->buffer_mb_arg), 
+                 &(args_info->buffer_mb_orig), &(args_info->buffer_mb_given),
+                &(local_args_info.buffer_mb_given), optarg, 0, "0", ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "buffer-mb", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* when ADIOS allocates its buffer: default (left to ADIOS), now (at start-up) or later (at the first open); needs --buffer-mb, no effect since ADIOS 1.10.  */
+          else if (strcmp (long_options[option_index].name, "buffer-alloc") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->buffer_alloc_arg), 
+                 &(args_info->buffer_alloc_orig), &(args_info->buffer_alloc_given),
+                &(local_args_info.buffer_alloc_given), optarg, 0, "default", ARG_STRING,
+                check_ambiguity, override, 0, 0,
+                "buffer-alloc", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* block sizes over ranks: uniform, linear, zipf, heavy (every 8th rank) or zero (every 4th rank empty).  */
+          else if (strcmp (long_options[option_index].name, "imbalance") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->imbalance_arg), 
+                 &(args_info->imbalance_orig), &(args_info->imbalance_given),
+                &(local_args_info.imbalance_given), optarg, 0, "uniform", ARG_STRING,
+                check_ambiguity, override, 0, 0,
+                "imbalance", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* imbalance strength: largest/smallest - 1 for linear and heavy, exponent for zipf.  */
+          else if (strcmp (long_options[option_index].name, "skew") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->skew_arg), 
+                 &(args_info->skew_orig), &(args_info->skew_given),
+                &(local_args_info.skew_given), optarg, 0, "1", ARG_DOUBLE,
+                check_ambiguity, override, 0, 0,
+                "skew", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* aggregator placement for num_aggregators of the write method (MPI_AGGREGATE): rank (as launched), spread (round-robin over nodes), pack (fewest nodes), or a file with one line per aggregator: its rank, then its members.  */
+          else if (strcmp (long_options[option_index].name, "placement") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->placement_arg), 
+                 &(args_info->placement_orig), &(args_info->placement_given),
+                &(local_args_info.placement_given), optarg, 0, "rank", ARG_STRING,
+                check_ambiguity, override, 0, 0,
+                "placement", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* treat every N consecutive ranks as a node, to emulate nodes on one (0: shared-memory nodes).  */
+          else if (strcmp (long_options[option_index].name, "ranks-per-node") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->ranks_per_node_arg), 
+                 &(args_info->ranks_per_node_orig), &(args_info->ranks_per_node_given),
+                &(local_args_info.ranks_per_node_given), optarg, 0, "0", ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "ranks-per-node", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* global array length split over the processes, the remainder to the low ranks (strong scaling; overrides len, and sweep and --type lengths become global).  */
+          else if (strcmp (long_options[option_index].name, "global-len") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->global_len_arg), 
+                 &(args_info->global_len_orig), &(args_info->global_len_given),
+                &(local_args_info.global_len_given), optarg, 0, 0, ARG_LONG,
+                check_ambiguity, override, 0, 0,
+                "global-len", '-',
+                additional_error))
+              goto failure;
+          
           }
           /* number of time steps.  */
           else if (strcmp (long_options[option_index].name, "nstep") == 0)
@@ -614,6 +995,48 @@ cmdline_parser_internal (
                 additional_error))
               goto failure;
           
+          }
+          /* compute phase of --sleep seconds between steps: sleep, stream (memory-bound triad), flops (compute-bound), or halo (neighbour exchange over MPI).  */
+          else if (strcmp (long_options[option_index].name, "compute") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->compute_arg), 
+                 &(args_info->compute_orig), &(args_info->compute_given),
+                &(local_args_info.compute_given), optarg, 0, "sleep", ARG_STRING,
+                check_ambiguity, override, 0, 0,
+                "compute", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* working set of the stream and halo kernels per process in MB.  */
+          else if (strcmp (long_options[option_index].name, "compute-mb") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->compute_mb_arg), 
+                 &(args_info->compute_mb_orig), &(args_info->compute_mb_given),
+                &(local_args_info.compute_mb_given), optarg, 0, "64", ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "compute-mb", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* halo sent to each neighbour per iteration of the halo kernel in KB.  */
+          else if (strcmp (long_options[option_index].name, "halo-kb") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->halo_kb_arg), 
+                 &(args_info->halo_kb_orig), &(args_info->halo_kb_given),
+                &(local_args_info.halo_kb_given), optarg, 0, "64", ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "halo-kb", '-',
+                additional_error))
+              goto failure;
+          
           }
           /* append.  */
           else if (strcmp (long_options[option_index].name, "append") == 0)
@@ -626,6 +1049,288 @@ cmdline_parser_internal (
                 additional_error))
               goto failure;
           
+          }
+          /* number of step buffers for overlapped writes on an I/O thread (<2: serial).  */
+          else if (strcmp (long_options[option_index].name, "pipeline") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->pipeline_arg), 
+                 &(args_info->pipeline_orig), &(args_info->pipeline_given),
+                &(local_args_info.pipeline_given), optarg, 0, "0", ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "pipeline", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* memory ballast per process in MB.  */
+          else if (strcmp (long_options[option_index].name, "ballast-mb") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->ballast_mb_arg), 
+                 &(args_info->ballast_mb_orig), &(args_info->ballast_mb_given),
+                &(local_args_info.ballast_mb_given), optarg, 0, "512", ARG_LONG,
+                check_ambiguity, override, 0, 0,
+                "ballast-mb", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* memory ballast as a fraction of node memory, shared by the processes of a node (overrides ballast-mb).  */
+          else if (strcmp (long_options[option_index].name, "ballast-frac") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->ballast_frac_arg), 
+                 &(args_info->ballast_frac_orig), &(args_info->ballast_frac_given),
+                &(local_args_info.ballast_frac_given), optarg, 0, "0", ARG_DOUBLE,
+                check_ambiguity, override, 0, 0,
+                "ballast-frac", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* ballast touch pattern: none, memset, page or random.  */
+          else if (strcmp (long_options[option_index].name, "touch") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->touch_arg), 
+                 &(args_info->touch_orig), &(args_info->touch_given),
+                &(local_args_info.touch_given), optarg, 0, "memset", ARG_STRING,
+                check_ambiguity, override, 0, 0,
+                "touch", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* use transparent huge pages for the ballast.  */
+          else if (strcmp (long_options[option_index].name, "thp") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->thp_flag), 0, &(args_info->thp_given),
+                &(local_args_info.thp_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "thp", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* touch the ballast again every N steps (0: never).  */
+          else if (strcmp (long_options[option_index].name, "retouch") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->retouch_arg), 
+                 &(args_info->retouch_orig), &(args_info->retouch_given),
+                &(local_args_info.retouch_given), optarg, 0, "0", ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "retouch", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* write per-step statistics over ranks and the run configuration to FILE (JSON, or CSV for a .csv name).  */
+          else if (strcmp (long_options[option_index].name, "results") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->results_arg), 
+                 &(args_info->results_orig), &(args_info->results_given),
+                &(local_args_info.results_given), optarg, 0, 0, ARG_STRING,
+                check_ambiguity, override, 0, 0,
+                "results", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* burst buffer: FILE is on node-local storage and a thread per node copies each closed step to this directory.  */
+          else if (strcmp (long_options[option_index].name, "drain") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->drain_arg), 
+                 &(args_info->drain_orig), &(args_info->drain_given),
+                &(local_args_info.drain_given), optarg, 0, 0, ARG_STRING,
+                check_ambiguity, override, 0, 0,
+                "drain", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* write a per-rank timeline of the run to FILE (Chrome trace JSON, for chrome://tracing or Perfetto).  */
+          else if (strcmp (long_options[option_index].name, "trace") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->trace_arg), 
+                 &(args_info->trace_orig), &(args_info->trace_given),
+                &(local_args_info.trace_given), optarg, 0, 0, ARG_STRING,
+                check_ambiguity, override, 0, 0,
+                "trace", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* report per-node bandwidth, the slowest node and rank of each phase, a histogram of rank times and persistent stragglers.  */
+          else if (strcmp (long_options[option_index].name, "stragglers") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->stragglers_flag), 0, &(args_info->stragglers_given),
+                &(local_args_info.stragglers_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "stragglers", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* do not print per-rank timing lines.  */
+          else if (strcmp (long_options[option_index].name, "quiet") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->quiet_flag), 0, &(args_info->quiet_given),
+                &(local_args_info.quiet_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "quiet", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* run every configuration of FILE in this job, one "LEN [METHOD [PARAMS [NVARS [IMBALANCE [PLACEMENT]]]]]" per line.  */
+          else if (strcmp (long_options[option_index].name, "sweep") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->sweep_arg), 
+                 &(args_info->sweep_orig), &(args_info->sweep_given),
+                &(local_args_info.sweep_given), optarg, 0, 0, ARG_STRING,
+                check_ambiguity, override, 0, 0,
+                "sweep", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* also write a checksum of each block for reader --checksum.  */
+          else if (strcmp (long_options[option_index].name, "checksum") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->checksum_flag), 0, &(args_info->checksum_given),
+                &(local_args_info.checksum_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "checksum", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* data pattern: ramp, constant, random, smooth or sparse.  */
+          else if (strcmp (long_options[option_index].name, "pattern") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->pattern_arg), 
+                 &(args_info->pattern_orig), &(args_info->pattern_given),
+                &(local_args_info.pattern_given), optarg, 0, "ramp", ARG_STRING,
+                check_ambiguity, override, 0, 0,
+                "pattern", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* threads generating each step.  */
+          else if (strcmp (long_options[option_index].name, "fill-threads") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->fill_threads_arg), 
+                 &(args_info->fill_threads_orig), &(args_info->fill_threads_given),
+                &(local_args_info.fill_threads_given), optarg, 0, "1", ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "fill-threads", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* ADIOS transform of x, e.g. zlib:9, bzip2, szip, sz:abs=0.001 or zfp:accuracy=0.001.  */
+          else if (strcmp (long_options[option_index].name, "transform") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->transform_arg), 
+                 &(args_info->transform_orig), &(args_info->transform_given),
+                &(local_args_info.transform_given), optarg, 0, "", ARG_STRING,
+                check_ambiguity, override, 0, 0,
+                "transform", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* number of extra arrays v0..vN-1 written next to x.  */
+          else if (strcmp (long_options[option_index].name, "nvars") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->nvars_arg), 
+                 &(args_info->nvars_orig), &(args_info->nvars_given),
+                &(local_args_info.nvars_given), optarg, 0, "0", ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "nvars", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* types of the extra arrays, cycled: comma-separated TYPE[:LEN] with TYPE byte, short, int, long, float, double, complex or dcomplex (LEN: len).  */
+          else if (strcmp (long_options[option_index].name, "type") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->type_arg), 
+                 &(args_info->type_orig), &(args_info->type_given),
+                &(local_args_info.type_given), optarg, 0, "double", ARG_STRING,
+                check_ambiguity, override, 0, 0,
+                "type", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* search num_aggregators and num_ost of the write method (MPI_AGGREGATE) for the best bandwidth, nstep steps per candidate.  */
+          else if (strcmp (long_options[option_index].name, "autotune") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->autotune_flag), 0, &(args_info->autotune_given),
+                &(local_args_info.autotune_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "autotune", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* largest num_ost the auto-tuner tries.  */
+          else if (strcmp (long_options[option_index].name, "tune-max-ost") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->tune_max_ost_arg), 
+                 &(args_info->tune_max_ost_orig), &(args_info->tune_max_ost_given),
+                &(local_args_info.tune_max_ost_given), optarg, 0, "16", ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "tune-max-ost", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* fsync the output files before stopping the clock of each step, reporting durable next to buffered bandwidth.  */
+          else if (strcmp (long_options[option_index].name, "durable") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->durable_flag), 0, &(args_info->durable_given),
+                &(local_args_info.durable_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "durable", '-',
+                additional_error))
+              goto failure;
+          
           }
           
           break;
@@ -45,26 +45,144 @@ struct gengetopt_args_info
   char * wparams_arg;	/**< @brief write method params (default='local-fs=1;have_metadata_file=1').  */
   char * wparams_orig;	/**< @brief write method params original value given at command line.  */
   const char *wparams_help; /**< @brief write method params help description.  */
+  int buffer_mb_arg;	/**< @brief maximum ADIOS buffer per process in MB (0: the ADIOS default) (default='0').  */
+  char * buffer_mb_orig;	/**< @brief maximum ADIOS buffer per process in MB (0: the ADIOS default) original value given at command line.  */
+  const char *buffer_mb_help; /**< @brief maximum ADIOS buffer per process in MB (0: the ADIOS default) help description.  */
+  char * buffer_alloc_arg;	/**< @brief when ADIOS allocates its buffer: default (left to ADIOS), now (at start-up) or later (at the first open); needs --buffer-mb, no effect since ADIOS 1.10 (default='default').  */
+  char * buffer_alloc_orig;	/**< @brief when ADIOS allocates its buffer: default (left to ADIOS), now (at start-up) or later (at the first open); needs --buffer-mb, no effect since ADIOS 1.10 original value given at command line.  */
+  const char *buffer_alloc_help; /**< @brief when ADIOS allocates its buffer: default (left to ADIOS), now (at start-up) or later (at the first open); needs --buffer-mb, no effect since ADIOS 1.10 help description.  */
   long len_arg;	/**< @brief array length (default='1000').  */
   char * len_orig;	/**< @brief array length original value given at command line.  */
   const char *len_help; /**< @brief array length help description.  */
+  char * imbalance_arg;	/**< @brief block sizes over ranks: uniform, linear, zipf, heavy (every 8th rank) or zero (every 4th rank empty) (default='uniform').  */
+  char * imbalance_orig;	/**< @brief block sizes over ranks: uniform, linear, zipf, heavy (every 8th rank) or zero (every 4th rank empty) original value given at command line.  */
+  const char *imbalance_help; /**< @brief block sizes over ranks: uniform, linear, zipf, heavy (every 8th rank) or zero (every 4th rank empty) help description.  */
+  double skew_arg;	/**< @brief imbalance strength: largest/smallest - 1 for linear and heavy, exponent for zipf (default='1').  */
+  char * skew_orig;	/**< @brief imbalance strength: largest/smallest - 1 for linear and heavy, exponent for zipf original value given at command line.  */
+  const char *skew_help; /**< @brief imbalance strength: largest/smallest - 1 for linear and heavy, exponent for zipf help description.  */
+  char * placement_arg;	/**< @brief aggregator placement for num_aggregators of the write method (MPI_AGGREGATE): rank (as launched), spread (round-robin over nodes), pack (fewest nodes), or a file with one line per aggregator: its rank, then its members (default='rank').  */
+  char * placement_orig;	/**< @brief aggregator placement for num_aggregators of the write method (MPI_AGGREGATE): rank (as launched), spread (round-robin over nodes), pack (fewest nodes), or a file with one line per aggregator: its rank, then its members original value given at command line.  */
+  const char *placement_help; /**< @brief aggregator placement for num_aggregators of the write method (MPI_AGGREGATE): rank (as launched), spread (round-robin over nodes), pack (fewest nodes), or a file with one line per aggregator: its rank, then its members help description.  */
+  int ranks_per_node_arg;	/**< @brief treat every N consecutive ranks as a node, to emulate nodes on one (0: shared-memory nodes) (default='0').  */
+  char * ranks_per_node_orig;	/**< @brief treat every N consecutive ranks as a node, to emulate nodes on one (0: shared-memory nodes) original value given at command line.  */
+  const char *ranks_per_node_help; /**< @brief treat every N consecutive ranks as a node, to emulate nodes on one (0: shared-memory nodes) help description.  */
+  long global_len_arg;	/**< @brief global array length split over the processes, the remainder to the low ranks (strong scaling; overrides len, and sweep and --type lengths become global).  */
+  char * global_len_orig;	/**< @brief global array length split over the processes, the remainder to the low ranks (strong scaling; overrides len, and sweep and --type lengths become global) original value given at command line.  */
+  const char *global_len_help; /**< @brief global array length split over the processes, the remainder to the low ranks (strong scaling; overrides len, and sweep and --type lengths become global) help description.  */
   int nstep_arg;	/**< @brief number of time steps (default='1').  */
   char * nstep_orig;	/**< @brief number of time steps original value given at command line.  */
   const char *nstep_help; /**< @brief number of time steps help description.  */
   int sleep_arg;	/**< @brief interval time (default='3').  */
   char * sleep_orig;	/**< @brief interval time original value given at command line.  */
   const char *sleep_help; /**< @brief interval time help description.  */
+  char * compute_arg;	/**< @brief compute phase of --sleep seconds between steps: sleep, stream (memory-bound triad), flops (compute-bound), or halo (neighbour exchange over MPI) (default='sleep').  */
+  char * compute_orig;	/**< @brief compute phase of --sleep seconds between steps: sleep, stream (memory-bound triad), flops (compute-bound), or halo (neighbour exchange over MPI) original value given at command line.  */
+  const char *compute_help; /**< @brief compute phase of --sleep seconds between steps: sleep, stream (memory-bound triad), flops (compute-bound), or halo (neighbour exchange over MPI) help description.  */
+  int compute_mb_arg;	/**< @brief working set of the stream and halo kernels per process in MB (default='64').  */
+  char * compute_mb_orig;	/**< @brief working set of the stream and halo kernels per process in MB original value given at command line.  */
+  const char *compute_mb_help; /**< @brief working set of the stream and halo kernels per process in MB help description.  */
+  int halo_kb_arg;	/**< @brief halo sent to each neighbour per iteration of the halo kernel in KB (default='64').  */
+  char * halo_kb_orig;	/**< @brief halo sent to each neighbour per iteration of the halo kernel in KB original value given at command line.  */
+  const char *halo_kb_help; /**< @brief halo sent to each neighbour per iteration of the halo kernel in KB help description.  */
   int append_flag;	/**< @brief append (default=off).  */
   const char *append_help; /**< @brief append help description.  */
+  int pipeline_arg;	/**< @brief number of step buffers for overlapped writes on an I/O thread (<2: serial) (default='0').  */
+  char * pipeline_orig;	/**< @brief number of step buffers for overlapped writes on an I/O thread (<2: serial) original value given at command line.  */
+  const char *pipeline_help; /**< @brief number of step buffers for overlapped writes on an I/O thread (<2: serial) help description.  */
+  long ballast_mb_arg;	/**< @brief memory ballast per process in MB (default='512').  */
+  char * ballast_mb_orig;	/**< @brief memory ballast per process in MB original value given at command line.  */
+  const char *ballast_mb_help; /**< @brief memory ballast per process in MB help description.  */
+  double ballast_frac_arg;	/**< @brief memory ballast as a fraction of node memory, shared by the processes of a node (overrides ballast-mb) (default='0').  */
+  char * ballast_frac_orig;	/**< @brief memory ballast as a fraction of node memory, shared by the processes of a node (overrides ballast-mb) original value given at command line.  */
+  const char *ballast_frac_help; /**< @brief memory ballast as a fraction of node memory, shared by the processes of a node (overrides ballast-mb) help description.  */
+  char * touch_arg;	/**< @brief ballast touch pattern: none, memset, page or random (default='memset').  */
+  char * touch_orig;	/**< @brief ballast touch pattern: none, memset, page or random original value given at command line.  */
+  const char *touch_help; /**< @brief ballast touch pattern: none, memset, page or random help description.  */
+  int thp_flag;	/**< @brief use transparent huge pages for the ballast (default=off).  */
+  const char *thp_help; /**< @brief use transparent huge pages for the ballast help description.  */
+  int retouch_arg;	/**< @brief touch the ballast again every N steps (0: never) (default='0').  */
+  char * retouch_orig;	/**< @brief touch the ballast again every N steps (0: never) original value given at command line.  */
+  const char *retouch_help; /**< @brief touch the ballast again every N steps (0: never) help description.  */
+  char * results_arg;	/**< @brief write per-step statistics over ranks and the run configuration to FILE (JSON, or CSV for a .csv name).  */
+  char * results_orig;	/**< @brief write per-step statistics over ranks and the run configuration to FILE (JSON, or CSV for a .csv name) original value given at command line.  */
+  const char *results_help; /**< @brief write per-step statistics over ranks and the run configuration to FILE (JSON, or CSV for a .csv name) help description.  */
+  char * drain_arg;	/**< @brief burst buffer: FILE is on node-local storage and a thread per node copies each closed step to this directory.  */
+  char * drain_orig;	/**< @brief burst buffer: FILE is on node-local storage and a thread per node copies each closed step to this directory original value given at command line.  */
+  const char *drain_help; /**< @brief burst buffer: FILE is on node-local storage and a thread per node copies each closed step to this directory help description.  */
+  char * trace_arg;	/**< @brief write a per-rank timeline of the run to FILE (Chrome trace JSON, for chrome://tracing or Perfetto).  */
+  char * trace_orig;	/**< @brief write a per-rank timeline of the run to FILE (Chrome trace JSON, for chrome://tracing or Perfetto) original value given at command line.  */
+  const char *trace_help; /**< @brief write a per-rank timeline of the run to FILE (Chrome trace JSON, for chrome://tracing or Perfetto) help description.  */
+  int stragglers_flag;	/**< @brief report per-node bandwidth, the slowest node and rank of each phase, a histogram of rank times and persistent stragglers (default=off).  */
+  const char *stragglers_help; /**< @brief report per-node bandwidth, the slowest node and rank of each phase, a histogram of rank times and persistent stragglers help description.  */
+  int quiet_flag;	/**< @brief do not print per-rank timing lines (default=off).  */
+  const char *quiet_help; /**< @brief do not print per-rank timing lines help description.  */
+  char * sweep_arg;	/**< @brief run every configuration of FILE in this job, one "LEN [METHOD [PARAMS [NVARS [IMBALANCE [PLACEMENT]]]]]" per line.  */
+  char * sweep_orig;	/**< @brief run every configuration of FILE in this job, one "LEN [METHOD [PARAMS [NVARS [IMBALANCE [PLACEMENT]]]]]" per line original value given at command line.  */
+  const char *sweep_help; /**< @brief run every configuration of FILE in this job, one "LEN [METHOD [PARAMS [NVARS [IMBALANCE [PLACEMENT]]]]]" per line help description.  */
+  int checksum_flag;	/**< @brief also write a checksum of each block for reader --checksum (default=off).  */
+  const char *checksum_help; /**< @brief also write a checksum of each block for reader --checksum help description.  */
+  char * pattern_arg;	/**< @brief data pattern: ramp, constant, random, smooth or sparse (default='ramp').  */
+  char * pattern_orig;	/**< @brief data pattern: ramp, constant, random, smooth or sparse original value given at command line.  */
+  const char *pattern_help; /**< @brief data pattern: ramp, constant, random, smooth or sparse help description.  */
+  int fill_threads_arg;	/**< @brief threads generating each step (default='1').  */
+  char * fill_threads_orig;	/**< @brief threads generating each step original value given at command line.  */
+  const char *fill_threads_help; /**< @brief threads generating each step help description.  */
+  char * transform_arg;	/**< @brief ADIOS transform of x, e.g. zlib:9, bzip2, szip, sz:abs=0.001 or zfp:accuracy=0.001 (default='').  */
+  char * transform_orig;	/**< @brief ADIOS transform of x, e.g. zlib:9, bzip2, szip, sz:abs=0.001 or zfp:accuracy=0.001 original value given at command line.  */
+  const char *transform_help; /**< @brief ADIOS transform of x, e.g. zlib:9, bzip2, szip, sz:abs=0.001 or zfp:accuracy=0.001 help description.  */
+  int nvars_arg;	/**< @brief number of extra arrays v0..vN-1 written next to x (default='0').  */
+  char * nvars_orig;	/**< @brief number of extra arrays v0..vN-1 written next to x original value given at command line.  */
+  const char *nvars_help; /**< @brief number of extra arrays v0..vN-1 written next to x help description.  */
+  char * type_arg;	/**< @brief types of the extra arrays, cycled: comma-separated TYPE[:LEN] with TYPE byte, short, int, long, float, double, complex or dcomplex (LEN: len) (default='double').  */
+  char * type_orig;	/**< @brief types of the extra arrays, cycled: comma-separated TYPE[:LEN] with TYPE byte, short, int, long, float, double, complex or dcomplex (LEN: len) original value given at command line.  */
+  const char *type_help; /**< @brief types of the extra arrays, cycled: comma-separated TYPE[:LEN] with TYPE byte, short, int, long, float, double, complex or dcomplex (LEN: len) help description.  */
+  int autotune_flag;	/**< @brief search num_aggregators and num_ost of the write method (MPI_AGGREGATE) for the best bandwidth, nstep steps per candidate (default=off).  */
+  const char *autotune_help; /**< @brief search num_aggregators and num_ost of the write method (MPI_AGGREGATE) for the best bandwidth, nstep steps per candidate help description.  */
+  int tune_max_ost_arg;	/**< @brief largest num_ost the auto-tuner tries (default='16').  */
+  char * tune_max_ost_orig;	/**< @brief largest num_ost the auto-tuner tries original value given at command line.  */
+  const char *tune_max_ost_help; /**< @brief largest num_ost the auto-tuner tries help description.  */
+  int durable_flag;	/**< @brief fsync the output files before stopping the clock of each step, reporting durable next to buffered bandwidth (default=off).  */
+  const char *durable_help; /**< @brief fsync the output files before stopping the clock of each step, reporting durable next to buffered bandwidth help description.  */
   
   unsigned int help_given ;	/**< @brief Whether help was given.  */
   unsigned int version_given ;	/**< @brief Whether version was given.  */
   unsigned int writemethod_given ;	/**< @brief Whether writemethod was given.  */
   unsigned int wparams_given ;	/**< @brief Whether wparams was given.  */
+  unsigned int buffer_mb_given ;	/**< @brief Whether buffer-mb was given.  */
+  unsigned int buffer_alloc_given ;	/**< @brief Whether buffer-alloc was given.  */
   unsigned int len_given ;	/**< @brief Whether len was given.  */
+  unsigned int imbalance_given ;	/**< @brief Whether imbalance was given.  */
+  unsigned int skew_given ;	/**< @brief Whether skew was given.  */
+  unsigned int placement_given ;	/**< @brief Whether placement was given.  */
+  unsigned int ranks_per_node_given ;	/**< @brief Whether ranks-per-node was given.  */
+  unsigned int global_len_given ;	/**< @brief Whether global-len was given.  */
   unsigned int nstep_given ;	/**< @brief Whether nstep was given.  */
   unsigned int sleep_given ;	/**< @brief Whether sleep was given.  */
+  unsigned int compute_given ;	/**< @brief Whether compute was given.  */
+  unsigned int compute_mb_given ;	/**< @brief Whether compute-mb was given.  */
+  unsigned int halo_kb_given ;	/**< @brief Whether halo-kb was given.  */
   unsigned int append_given ;	/**< @brief Whether append was given.  */
+  unsigned int pipeline_given ;	/**< @brief Whether pipeline was given.  */
+  unsigned int ballast_mb_given ;	/**< @brief Whether ballast-mb was given.  */
+  unsigned int ballast_frac_given ;	/**< @brief Whether ballast-frac was given.  */
+  unsigned int touch_given ;	/**< @brief Whether touch was given.  */
+  unsigned int thp_given ;	/**< @brief Whether thp was given.  */
+  unsigned int retouch_given ;	/**< @brief Whether retouch was given.  */
+  unsigned int results_given ;	/**< @brief Whether results was given.  */
+  unsigned int drain_given ;	/**< @brief Whether drain was given.  */
+  unsigned int trace_given ;	/**< @brief Whether trace was given.  */
+  unsigned int stragglers_given ;	/**< @brief Whether stragglers was given.  */
+  unsigned int quiet_given ;	/**< @brief Whether quiet was given.  */
+  unsigned int sweep_given ;	/**< @brief Whether sweep was given.  */
+  unsigned int checksum_given ;	/**< @brief Whether checksum was given.  */
+  unsigned int pattern_given ;	/**< @brief Whether pattern was given.  */
+  unsigned int fill_threads_given ;	/**< @brief Whether fill-threads was given.  */
+  unsigned int transform_given ;	/**< @brief Whether transform was given.  */
+  unsigned int nvars_given ;	/**< @brief Whether nvars was given.  */
+  unsigned int type_given ;	/**< @brief Whether type was given.  */
+  unsigned int autotune_given ;	/**< @brief Whether autotune was given.  */
+  unsigned int tune_max_ost_given ;	/**< @brief Whether tune-max-ost was given.  */
+  unsigned int durable_given ;	/**< @brief Whether durable was given.  */
 
   char **inputs ; /**< @brief unamed options (options without names) */
   unsigned inputs_num ; /**< @brief unamed options number */
@@ -0,0 +1,1067 @@
+/*
+  File autogenerated by gengetopt version 2.22.6
+  generated with the following command:
+  gengetopt --input=cmdline_reader.ggo --no-handle-version --file=cmdline_reader --unamed-opts=FILE
+
+  The developers of gengetopt consider the fixed text that goes in all
+  gengetopt output files to be in the public domain:
+  we make no copyright claims on it.
+*/
+
+/* If we use autoconf.  */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef FIX_UNUSED
+#define FIX_UNUSED(X) (void) (X) /* avoid warnings for unused params */
+#endif
+
+#include <getopt.h>
+
+#include "cmdline_reader.h"
+
+const char *gengetopt_args_info_purpose = "";
+
+const char *gengetopt_args_info_usage = "Usage: reader [OPTIONS]... [FILE]...";
+
+const char *gengetopt_args_info_versiontext = "";
+
+const char *gengetopt_args_info_description = "";
+
+const char *gengetopt_args_info_help[] = {
+  "  -h, --help                Print help and exit",
+  "  -V, --version             Print version and exit",
+  "      --decomp=STRING       reader decomposition: even (1D split of gnx) or\n                              block (whole writer blocks)  (default=`even')",
+  "      --stream              read one window of steps at a time into two\n                              rotating buffers  (default=off)",
+  "      --window=INT          number of steps per read in stream mode\n                              (default=`1')",
+  "      --chunked=STRING      schedule the reads per step (steps) or per\n                              selection (blocks), perform them non-blocking and\n                              verify and reduce each chunk on a worker thread as\n                              it completes",
+  "      --results=STRING      write per-step statistics over ranks and the run\n                              configuration to FILE (JSON, or CSV for a .csv\n                              name)",
+  "      --trace=STRING        write a per-rank timeline of the run to FILE\n                              (Chrome trace JSON, for chrome://tracing or\n                              Perfetto)",
+  "      --stragglers          report per-node bandwidth, the slowest node and\n                              rank of each phase, a histogram of rank times and\n                              persistent stragglers  (default=off)",
+  "      --ranks-per-node=INT  treat every N consecutive ranks as a node for\n                              --stragglers, to emulate nodes on one (0:\n                              shared-memory nodes)  (default=`0')",
+  "      --quiet               do not print per-rank timing lines  (default=off)",
+  "  -r, --readmethod=STRING   ADIOS read method: BP, BP_AGGREGATE, DATASPACES,\n                              DIMES, FLEXPATH or ICEE  (default=`BP')",
+  "      --rparams=STRING      read method params  (default=`')",
+  "  -v, --verbose=INT         ADIOS read method verbosity  (default=`3')",
+  "      --timeout=DOUBLE      seconds to wait for a stream to appear (staging\n                              methods) or, with --follow, for its next step\n                              (default=`60')",
+  "      --first-step=INT      first step to read  (default=`0')",
+  "      --nsteps=INT          number of steps to read (-1: all from first-step)\n                              (default=`-1')",
+  "      --selection=STRING    selection type: boundingbox or writeblock (whole\n                              writer blocks)  (default=`boundingbox')",
+  "      --no-verify           do not verify the data read  (default=off)",
+  "      --checksum            verify whole writer blocks by the checksums of\n                              writer --checksum instead of every value\n                              (default=off)",
+  "      --verify-threads=INT  threads verifying each read buffer  (default=`1')",
+  "      --physical            for transformed data, first read the stored bytes\n                              alone to time I/O apart from decoding\n                              (default=off)",
+  "      --follow              read the steps of a file as the writer appends\n                              them, one at a time, and report the latency from\n                              the writer  (default=off)",
+  "      --cold                drop the file from the page cache of every node\n                              before reading (file methods), then read it again\n                              warm  (default=off)",
+  "      --selection-bench     also read the whole writer blocks of each rank as\n                              bounding boxes, as writeblocks and a sample as\n                              points, timing metadata lookup, scheduling and\n                              reads of each  (default=off)",
+  "      --point-frac=DOUBLE   fraction of the block elements read as random\n                              points by --selection-bench  (default=`0.01')",
+    0
+};
+
+typedef enum {ARG_NO
+  , ARG_FLAG
+  , ARG_STRING
+  , ARG_INT
+  , ARG_DOUBLE
+} cmdline_parser_arg_type;
+
+static
+void clear_given (struct gengetopt_args_info *args_info);
+static
+void clear_args (struct gengetopt_args_info *args_info);
+
+static int
+cmdline_parser_internal (int argc, char **argv, struct gengetopt_args_info *args_info,
+                        struct cmdline_parser_params *params, const char *additional_error);
+
+
+static char *
+gengetopt_strdup (const char *s);
+
+static
+void clear_given (struct gengetopt_args_info *args_info)
+{
+  args_info->help_given = 0 ;
+  args_info->version_given = 0 ;
+  args_info->decomp_given = 0 ;
+  args_info->stream_given = 0 ;
+  args_info->window_given = 0 ;
+  args_info->chunked_given = 0 ;
+  args_info->results_given = 0 ;
+  args_info->trace_given = 0 ;
+  args_info->stragglers_given = 0 ;
+  args_info->ranks_per_node_given = 0 ;
+  args_info->quiet_given = 0 ;
+  args_info->readmethod_given = 0 ;
+  args_info->rparams_given = 0 ;
+  args_info->verbose_given = 0 ;
+  args_info->timeout_given = 0 ;
+  args_info->first_step_given = 0 ;
+  args_info->nsteps_given = 0 ;
+  args_info->selection_given = 0 ;
+  args_info->no_verify_given = 0 ;
+  args_info->checksum_given = 0 ;
+  args_info->verify_threads_given = 0 ;
+  args_info->physical_given = 0 ;
+  args_info->follow_given = 0 ;
+  args_info->cold_given = 0 ;
+  args_info->selection_bench_given = 0 ;
+  args_info->point_frac_given = 0 ;
+}
+
+static
+void clear_args (struct gengetopt_args_info *args_info)
+{
+  FIX_UNUSED (args_info);
+  args_info->decomp_arg = gengetopt_strdup ("even");
+  args_info->decomp_orig = NULL;
+  args_info->stream_flag = 0;
+  args_info->window_arg = 1;
+  args_info->window_orig = NULL;
+  args_info->chunked_arg = NULL;
+  args_info->chunked_orig = NULL;
+  args_info->results_arg = NULL;
+  args_info->results_orig = NULL;
+  args_info->trace_arg = NULL;
+  args_info->trace_orig = NULL;
+  args_info->stragglers_flag = 0;
+  args_info->ranks_per_node_arg = 0;
+  args_info->ranks_per_node_orig = NULL;
+  args_info->quiet_flag = 0;
+  args_info->readmethod_arg = gengetopt_strdup ("BP");
+  args_info->readmethod_orig = NULL;
+  args_info->rparams_arg = gengetopt_strdup ("");
+  args_info->rparams_orig = NULL;
+  args_info->verbose_arg = 3;
+  args_info->verbose_orig = NULL;
+  args_info->timeout_arg = 60;
+  args_info->timeout_orig = NULL;
+  args_info->first_step_arg = 0;
+  args_info->first_step_orig = NULL;
+  args_info->nsteps_arg = -1;
+  args_info->nsteps_orig = NULL;
+  args_info->selection_arg = gengetopt_strdup ("boundingbox");
+  args_info->selection_orig = NULL;
+  args_info->no_verify_flag = 0;
+  args_info->checksum_flag = 0;
+  args_info->verify_threads_arg = 1;
+  args_info->verify_threads_orig = NULL;
+  args_info->physical_flag = 0;
+  args_info->follow_flag = 0;
+  args_info->cold_flag = 0;
+  args_info->selection_bench_flag = 0;
+  args_info->point_frac_arg = 0.01;
+  args_info->point_frac_orig = NULL;
+  
+}
+
+static
+void init_args_info(struct gengetopt_args_info *args_info)
+{
+
+
+  args_info->help_help = gengetopt_args_info_help[0] ;
+  args_info->version_help = gengetopt_args_info_help[1] ;
+  args_info->decomp_help = gengetopt_args_info_help[2] ;
+  args_info->stream_help = gengetopt_args_info_help[3] ;
+  args_info->window_help = gengetopt_args_info_help[4] ;
+  args_info->chunked_help = gengetopt_args_info_help[5] ;
+  args_info->results_help = gengetopt_args_info_help[6] ;
+  args_info->trace_help = gengetopt_args_info_help[7] ;
+  args_info->stragglers_help = gengetopt_args_info_help[8] ;
+  args_info->ranks_per_node_help = gengetopt_args_info_help[9] ;
+  args_info->quiet_help = gengetopt_args_info_help[10] ;
+  args_info->readmethod_help = gengetopt_args_info_help[11] ;
+  args_info->rparams_help = gengetopt_args_info_help[12] ;
+  args_info->verbose_help = gengetopt_args_info_help[13] ;
+  args_info->timeout_help = gengetopt_args_info_help[14] ;
+  args_info->first_step_help = gengetopt_args_info_help[15] ;
+  args_info->nsteps_help = gengetopt_args_info_help[16] ;
+  args_info->selection_help = gengetopt_args_info_help[17] ;
+  args_info->no_verify_help = gengetopt_args_info_help[18] ;
+  args_info->checksum_help = gengetopt_args_info_help[19] ;
+  args_info->verify_threads_help = gengetopt_args_info_help[20] ;
+  args_info->physical_help = gengetopt_args_info_help[21] ;
+  args_info->follow_help = gengetopt_args_info_help[22] ;
+  args_info->cold_help = gengetopt_args_info_help[23] ;
+  args_info->selection_bench_help = gengetopt_args_info_help[24] ;
+  args_info->point_frac_help = gengetopt_args_info_help[25] ;
+  
+}
+
+void
+cmdline_parser_print_version (void)
+{
+  printf ("%s %s\n",
+     (strlen(CMDLINE_PARSER_PACKAGE_NAME) ? CMDLINE_PARSER_PACKAGE_NAME : CMDLINE_PARSER_PACKAGE),
+     CMDLINE_PARSER_VERSION);
+
+  if (strlen(gengetopt_args_info_versiontext) > 0)
+    printf("\n%s\n", gengetopt_args_info_versiontext);
+}
+
+static void print_help_common(void) {
+  cmdline_parser_print_version ();
+
+  if (strlen(gengetopt_args_info_purpose) > 0)
+    printf("\n%s\n", gengetopt_args_info_purpose);
+
+  if (strlen(gengetopt_args_info_usage) > 0)
+    printf("\n%s\n", gengetopt_args_info_usage);
+
+  printf("\n");
+
+  if (strlen(gengetopt_args_info_description) > 0)
+    printf("%s\n\n", gengetopt_args_info_description);
+}
+
+void
+cmdline_parser_print_help (void)
+{
+  int i = 0;
+  print_help_common();
+  while (gengetopt_args_info_help[i])
+    printf("%s\n", gengetopt_args_info_help[i++]);
+}
+
+void
+cmdline_parser_init (struct gengetopt_args_info *args_info)
+{
+  clear_given (args_info);
+  clear_args (args_info);
+  init_args_info (args_info);
+
+  args_info->inputs = 0;
+  args_info->inputs_num = 0;
+}
+
+void
+cmdline_parser_params_init(struct cmdline_parser_params *params)
+{
+  if (params)
+    { 
+      params->override = 0;
+      params->initialize = 1;
+      params->check_required = 1;
+      params->check_ambiguity = 0;
+      params->print_errors = 1;
+    }
+}
+
+struct cmdline_parser_params *
+cmdline_parser_params_create(void)
+{
+  struct cmdline_parser_params *params = 
+    (struct cmdline_parser_params *)malloc(sizeof(struct cmdline_parser_params));
+  cmdline_parser_params_init(params);  
+  return params;
+}
+
+static void
+free_string_field (char **s)
+{
+  if (*s)
+    {
+      free (*s);
+      *s = 0;
+    }
+}
+
+
+static void
+cmdline_parser_release (struct gengetopt_args_info *args_info)
+{
+  unsigned int i;
+  free_string_field (&(args_info->decomp_arg));
+  free_string_field (&(args_info->decomp_orig));
+  free_string_field (&(args_info->window_orig));
+  free_string_field (&(args_info->chunked_arg));
+  free_string_field (&(args_info->chunked_orig));
+  free_string_field (&(args_info->results_arg));
+  free_string_field (&(args_info->results_orig));
+  free_string_field (&(args_info->trace_arg));
+  free_string_field (&(args_info->trace_orig));
+  free_string_field (&(args_info->ranks_per_node_orig));
+  free_string_field (&(args_info->readmethod_arg));
+  free_string_field (&(args_info->readmethod_orig));
+  free_string_field (&(args_info->rparams_arg));
+  free_string_field (&(args_info->rparams_orig));
+  free_string_field (&(args_info->verbose_orig));
+  free_string_field (&(args_info->timeout_orig));
+  free_string_field (&(args_info->first_step_orig));
+  free_string_field (&(args_info->nsteps_orig));
+  free_string_field (&(args_info->selection_arg));
+  free_string_field (&(args_info->selection_orig));
+  free_string_field (&(args_info->verify_threads_orig));
+  free_string_field (&(args_info->point_frac_orig));
+  
+  
+  for (i = 0; i < args_info->inputs_num; ++i)
+    free (args_info->inputs [i]);
+
+  if (args_info->inputs_num)
+    free (args_info->inputs);
+
+  clear_given (args_info);
+}
+
+
+static void
+write_into_file(FILE *outfile, const char *opt, const char *arg, const char *values[])
+{
+  FIX_UNUSED (values);
+  if (arg) {
+    fprintf(outfile, "%s=\"%s\"\n", opt, arg);
+  } else {
+    fprintf(outfile, "%s\n", opt);
+  }
+}
+
+
+int
+cmdline_parser_dump(FILE *outfile, struct gengetopt_args_info *args_info)
+{
+  int i = 0;
+
+  if (!outfile)
+    {
+      fprintf (stderr, "%s: cannot dump options to stream\n", CMDLINE_PARSER_PACKAGE);
+      return EXIT_FAILURE;
+    }
+
+  if (args_info->help_given)
+    write_into_file(outfile, "help", 0, 0 );
+  if (args_info->version_given)
+    write_into_file(outfile, "version", 0, 0 );
+  if (args_info->decomp_given)
+    write_into_file(outfile, "decomp", args_info->decomp_orig, 0);
+  if (args_info->stream_given)
+    write_into_file(outfile, "stream", 0, 0 );
+  if (args_info->window_given)
+    write_into_file(outfile, "window", args_info->window_orig, 0);
+  if (args_info->chunked_given)
+    write_into_file(outfile, "chunked", args_info->chunked_orig, 0);
+  if (args_info->results_given)
+    write_into_file(outfile, "results", args_info->results_orig, 0);
+  if (args_info->trace_given)
+    write_into_file(outfile, "trace", args_info->trace_orig, 0);
+  if (args_info->stragglers_given)
+    write_into_file(outfile, "stragglers", 0, 0 );
+  if (args_info->ranks_per_node_given)
+    write_into_file(outfile, "ranks-per-node", args_info->ranks_per_node_orig, 0);
+  if (args_info->quiet_given)
+    write_into_file(outfile, "quiet", 0, 0 );
+  if (args_info->readmethod_given)
+    write_into_file(outfile, "readmethod", args_info->readmethod_orig, 0);
+  if (args_info->rparams_given)
+    write_into_file(outfile, "rparams", args_info->rparams_orig, 0);
+  if (args_info->verbose_given)
+    write_into_file(outfile, "verbose", args_info->verbose_orig, 0);
+  if (args_info->timeout_given)
+    write_into_file(outfile, "timeout", args_info->timeout_orig, 0);
+  if (args_info->first_step_given)
+    write_into_file(outfile, "first-step", args_info->first_step_orig, 0);
+  if (args_info->nsteps_given)
+    write_into_file(outfile, "nsteps", args_info->nsteps_orig, 0);
+  if (args_info->selection_given)
+    write_into_file(outfile, "selection", args_info->selection_orig, 0);
+  if (args_info->no_verify_given)
+    write_into_file(outfile, "no-verify", 0, 0 );
+  if (args_info->checksum_given)
+    write_into_file(outfile, "checksum", 0, 0 );
+  if (args_info->verify_threads_given)
+    write_into_file(outfile, "verify-threads", args_info->verify_threads_orig, 0);
+  if (args_info->physical_given)
+    write_into_file(outfile, "physical", 0, 0 );
+  if (args_info->follow_given)
+    write_into_file(outfile, "follow", 0, 0 );
+  if (args_info->cold_given)
+    write_into_file(outfile, "cold", 0, 0 );
+  if (args_info->selection_bench_given)
+    write_into_file(outfile, "selection-bench", 0, 0 );
+  if (args_info->point_frac_given)
+    write_into_file(outfile, "point-frac", args_info->point_frac_orig, 0);
+  
+
+  i = EXIT_SUCCESS;
+  return i;
+}
+
+int
+cmdline_parser_file_save(const char *filename, struct gengetopt_args_info *args_info)
+{
+  FILE *outfile;
+  int i = 0;
+
+  outfile = fopen(filename, "w");
+
+  if (!outfile)
+    {
+      fprintf (stderr, "%s: cannot open file for writing: %s\n", CMDLINE_PARSER_PACKAGE, filename);
+      return EXIT_FAILURE;
+    }
+
+  i = cmdline_parser_dump(outfile, args_info);
+  fclose (outfile);
+
+  return i;
+}
+
+void
+cmdline_parser_free (struct gengetopt_args_info *args_info)
+{
+  cmdline_parser_release (args_info);
+}
+
+/** @brief replacement of strdup, which is not standard */
+char *
+gengetopt_strdup (const char *s)
+{
+  char *result = 0;
+  if (!s)
+    return result;
+
+  result = (char*)malloc(strlen(s) + 1);
+  if (result == (char*)0)
+    return (char*)0;
+  strcpy(result, s);
+  return result;
+}
+
+int
+cmdline_parser (int argc, char **argv, struct gengetopt_args_info *args_info)
+{
+  return cmdline_parser2 (argc, argv, args_info, 0, 1, 1);
+}
+
+int
+cmdline_parser_ext (int argc, char **argv, struct gengetopt_args_info *args_info,
+                   struct cmdline_parser_params *params)
+{
+  int result;
+  result = cmdline_parser_internal (argc, argv, args_info, params, 0);
+
+  if (result == EXIT_FAILURE)
+    {
+      cmdline_parser_free (args_info);
+      exit (EXIT_FAILURE);
+    }
+  
+  return result;
+}
+
+int
+cmdline_parser2 (int argc, char **argv, struct gengetopt_args_info *args_info, int override, int initialize, int check_required)
+{
+  int result;
+  struct cmdline_parser_params params;
+  
+  params.override = override;
+  params.initialize = initialize;
+  params.check_required = check_required;
+  params.check_ambiguity = 0;
+  params.print_errors = 1;
+
+  result = cmdline_parser_internal (argc, argv, args_info, &params, 0);
+
+  if (result == EXIT_FAILURE)
+    {
+      cmdline_parser_free (args_info);
+      exit (EXIT_FAILURE);
+    }
+  
+  return result;
+}
+
+int
+cmdline_parser_required (struct gengetopt_args_info *args_info, const char *prog_name)
+{
+  FIX_UNUSED (args_info);
+  FIX_UNUSED (prog_name);
+  return EXIT_SUCCESS;
+}
+
+
+static char *package_name = 0;
+
+/**
+ * @brief updates an option
+ * @param field the generic pointer to the field to update
+ * @param orig_field the pointer to the orig field
+ * @param field_given the pointer to the number of occurrence of this option
+ * @param prev_given the pointer to the number of occurrence already seen
+ * @param value the argument for this option (if null no arg was specified)
+ * @param possible_values the possible values for this option (if specified)
+ * @param default_value the default value (in case the option only accepts fixed values)
+ * @param arg_type the type of this option
+ * @param check_ambiguity @see cmdline_parser_params.check_ambiguity
+ * @param override @see cmdline_parser_params.override
+ * @param no_free whether to free a possible previous value
+ * @param multiple_option whether this is a multiple option
+ * @param long_opt the corresponding long option
+ * @param short_opt the corresponding short option (or '-' if none)
+ * @param additional_error possible further error specification
+ */
+static
+int update_arg(void *field, char **orig_field,
+               unsigned int *field_given, unsigned int *prev_given, 
+               char *value, const char *possible_values[],
+               const char *default_value,
+               cmdline_parser_arg_type arg_type,
+               int check_ambiguity, int override,
+               int no_free, int multiple_option,
+               const char *long_opt, char short_opt,
+               const char *additional_error)
+{
+  char *stop_char = 0;
+  const char *val = value;
+  int found;
+  char **string_field;
+  FIX_UNUSED (field);
+
+  stop_char = 0;
+  found = 0;
+
+  if (!multiple_option && prev_given && (*prev_given || (check_ambiguity && *field_given)))
+    {
+      if (short_opt != '-')
+        fprintf (stderr, "%s: `--%s' (`-%c') option given more than once%s\n", 
+               package_name, long_opt, short_opt,
+               (additional_error ? additional_error : ""));
+      else
+        fprintf (stderr, "%s: `--%s' option given more than once%s\n", 
+               package_name, long_opt,
+               (additional_error ? additional_error : ""));
+      return 1; /* failure */
+    }
+
+  FIX_UNUSED (default_value);
+    
+  if (field_given && *field_given && ! override)
+    return 0;
+  if (prev_given)
+    (*prev_given)++;
+  if (field_given)
+    (*field_given)++;
+  if (possible_values)
+    val = possible_values[found];
+
+  switch(arg_type) {
+  case ARG_FLAG:
+    *((int *)field) = !*((int *)field);
+    break;
+  case ARG_INT:
+    if (val) *((int *)field) = strtol (val, &stop_char, 0);
+    break;
+  case ARG_DOUBLE:
+    if (val) *((double *)field) = strtod (val, &stop_char);
+    break;
+  case ARG_STRING:
+    if (val) {
+      string_field = (char **)field;
+      if (!no_free && *string_field)
+        free (*string_field); /* free previous string */
+      *string_field = gengetopt_strdup (val);
+    }
+    break;
+  default:
+    break;
+  };
+
+  /* check numeric conversion */
+  switch(arg_type) {
+  case ARG_INT:
+  case ARG_DOUBLE:
+    if (val && !(stop_char && *stop_char == '\0')) {
+      fprintf(stderr, "%s: invalid numeric value: %s\n", package_name, val);
+      return 1; /* failure */
+    }
+    break;
+  default:
+    ;
+  };
+
+  /* store the original value */
+  switch(arg_type) {
+  case ARG_NO:
+  case ARG_FLAG:
+    break;
+  default:
+    if (value && orig_field) {
+      if (no_free) {
+        *orig_field = value;
+      } else {
+        if (*orig_field)
+          free (*orig_field); /* free previous string */
+        *orig_field = gengetopt_strdup (value);
+      }
+    }
+  };
+
+  return 0; /* OK */
+}
+
+
+int
+cmdline_parser_internal (
+  int argc, char **argv, struct gengetopt_args_info *args_info,
+                        struct cmdline_parser_params *params, const char *additional_error)
+{
+  int c;	/* Character of the parsed option.  */
+
+  int error_occurred = 0;
+  struct gengetopt_args_info local_args_info;
+  
+  int override;
+  int initialize;
+  int check_required;
+  int check_ambiguity;
+  
+  package_name = argv[0];
+  
+  override = params->override;
+  initialize = params->initialize;
+  check_required = params->check_required;
+  check_ambiguity = params->check_ambiguity;
+
+  if (initialize)
+    cmdline_parser_init (args_info);
+
+  cmdline_parser_init (&local_args_info);
+
+  optarg = 0;
+  optind = 0;
+  opterr = params->print_errors;
+  optopt = '?';
+
+  while (1)
+    {
+      int option_index = 0;
+
+      static struct option long_options[] = {
+        { "help",	0, NULL, 'h' },
+        { "version",	0, NULL, 'V' },
+        { "decomp",	1, NULL, 0 },
+        { "stream",	0, NULL, 0 },
+        { "window",	1, NULL, 0 },
+        { "chunked",	1, NULL, 0 },
+        { "results",	1, NULL, 0 },
+        { "trace",	1, NULL, 0 },
+        { "stragglers",	0, NULL, 0 },
+        { "ranks-per-node",	1, NULL, 0 },
+        { "quiet",	0, NULL, 0 },
+        { "readmethod",	1, NULL, 'r' },
+        { "rparams",	1, NULL, 0 },
+        { "verbose",	1, NULL, 'v' },
+        { "timeout",	1, NULL, 0 },
+        { "first-step",	1, NULL, 0 },
+        { "nsteps",	1, NULL, 0 },
+        { "selection",	1, NULL, 0 },
+        { "no-verify",	0, NULL, 0 },
+        { "checksum",	0, NULL, 0 },
+        { "verify-threads",	1, NULL, 0 },
+        { "physical",	0, NULL, 0 },
+        { "follow",	0, NULL, 0 },
+        { "cold",	0, NULL, 0 },
+        { "selection-bench",	0, NULL, 0 },
+        { "point-frac",	1, NULL, 0 },
+        { 0,  0, 0, 0 }
+      };
+
+      c = getopt_long (argc, argv, "hVr:v:", long_options, &option_index);
+
+      if (c == -1) break;	/* Exit from `while (1)' loop.  */
+
+      switch (c)
+        {
+        case 'h':	/* Print help and exit.  */
+          cmdline_parser_print_help ();
+          cmdline_parser_free (&local_args_info);
+          exit (EXIT_SUCCESS);
+
+        case 'V':	/* Print version and exit.  */
+        
+        
+          if (update_arg( 0 , 
+               0 , &(args_info->version_given),
+              &(local_args_info.version_given), optarg, 0, 0, ARG_NO,
+              check_ambiguity, override, 0, 0,
+              "version", 'V',
+              additional_error))
+            goto failure;
+          cmdline_parser_free (&local_args_info);
+          return 0;
+        
+          break;
+        case 'r':	/* ADIOS read method: BP, BP_AGGREGATE, DATASPACES, DIMES, FLEXPATH or ICEE.  */
+        
+        
+          if (update_arg( (void *)&(args_info->readmethod_arg), 
+               &(args_info->readmethod_orig), &(args_info->readmethod_given),
+              &(local_args_info.readmethod_given), optarg, 0, "BP", ARG_STRING,
+              check_ambiguity, override, 0, 0,
+              "readmethod", 'r',
+              additional_error))
+            goto failure;
+        
+          break;
+        case 'v':	/* ADIOS read method verbosity.  */
+        
+        
+          if (update_arg( (void *)&(args_info->verbose_arg), 
+               &(args_info->verbose_orig), &(args_info->verbose_given),
+              &(local_args_info.verbose_given), optarg, 0, "3", ARG_INT,
+              check_ambiguity, override, 0, 0,
+              "verbose", 'v',
+              additional_error))
+            goto failure;
+        
+          break;
+
+        case 0:	/* Long option with no short option */
+          /* reader decomposition: even (1D split of gnx) or block (whole writer blocks).  */
+          if (strcmp (long_options[option_index].name, "decomp") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->decomp_arg), 
+                 &(args_info->decomp_orig), &(args_info->decomp_given),
+                &(local_args_info.decomp_given), optarg, 0, "even", ARG_STRING,
+                check_ambiguity, override, 0, 0,
+                "decomp", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* read one window of steps at a time into two rotating buffers.  */
+          else if (strcmp (long_options[option_index].name, "stream") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->stream_flag), 0, &(args_info->stream_given),
+                &(local_args_info.stream_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "stream", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* number of steps per read in stream mode.  */
+          else if (strcmp (long_options[option_index].name, "window") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->window_arg), 
+                 &(args_info->window_orig), &(args_info->window_given),
+                &(local_args_info.window_given), optarg, 0, "1", ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "window", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* schedule the reads per step (steps) or per selection (blocks), perform them non-blocking and verify and reduce each chunk on a worker thread as it completes.  */
+          else if (strcmp (long_options[option_index].name, "chunked") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->chunked_arg), 
+                 &(args_info->chunked_orig), &(args_info->chunked_given),
+                &(local_args_info.chunked_given), optarg, 0, 0, ARG_STRING,
+                check_ambiguity, override, 0, 0,
+                "chunked", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* write per-step statistics over ranks and the run configuration to FILE (JSON, or CSV for a .csv name).  */
+          else if (strcmp (long_options[option_index].name, "results") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->results_arg), 
+                 &(args_info->results_orig), &(args_info->results_given),
+                &(local_args_info.results_given), optarg, 0, 0, ARG_STRING,
+                check_ambiguity, override, 0, 0,
+                "results", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* write a per-rank timeline of the run to FILE (Chrome trace JSON, for chrome://tracing or Perfetto).  */
+          else if (strcmp (long_options[option_index].name, "trace") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->trace_arg), 
+                 &(args_info->trace_orig), &(args_info->trace_given),
+                &(local_args_info.trace_given), optarg, 0, 0, ARG_STRING,
+                check_ambiguity, override, 0, 0,
+                "trace", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* report per-node bandwidth, the slowest node and rank of each phase, a histogram of rank times and persistent stragglers.  */
+          else if (strcmp (long_options[option_index].name, "stragglers") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->stragglers_flag), 0, &(args_info->stragglers_given),
+                &(local_args_info.stragglers_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "stragglers", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* treat every N consecutive ranks as a node for --stragglers, to emulate nodes on one (0: shared-memory nodes).  */
+          else if (strcmp (long_options[option_index].name, "ranks-per-node") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->ranks_per_node_arg), 
+                 &(args_info->ranks_per_node_orig), &(args_info->ranks_per_node_given),
+                &(local_args_info.ranks_per_node_given), optarg, 0, "0", ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "ranks-per-node", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* do not print per-rank timing lines.  */
+          else if (strcmp (long_options[option_index].name, "quiet") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->quiet_flag), 0, &(args_info->quiet_given),
+                &(local_args_info.quiet_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "quiet", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* read method params.  */
+          else if (strcmp (long_options[option_index].name, "rparams") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->rparams_arg), 
+                 &(args_info->rparams_orig), &(args_info->rparams_given),
+                &(local_args_info.rparams_given), optarg, 0, "", ARG_STRING,
+                check_ambiguity, override, 0, 0,
+                "rparams", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* seconds to wait for a stream to appear (staging methods) or, with --follow, for its next step.  */
+          else if (strcmp (long_options[option_index].name, "timeout") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->timeout_arg), 
+                 &(args_info->timeout_orig), &(args_info->timeout_given),
+                &(local_args_info.timeout_given), optarg, 0, "60", ARG_DOUBLE,
+                check_ambiguity, override, 0, 0,
+                "timeout", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* first step to read.  */
+          else if (strcmp (long_options[option_index].name, "first-step") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->first_step_arg), 
+                 &(args_info->first_step_orig), &(args_info->first_step_given),
+                &(local_args_info.first_step_given), optarg, 0, "0", ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "first-step", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* number of steps to read (-1: all from first-step).  */
+          else if (strcmp (long_options[option_index].name, "nsteps") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->nsteps_arg), 
+                 &(args_info->nsteps_orig), &(args_info->nsteps_given),
+                &(local_args_info.nsteps_given), optarg, 0, "-1", ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "nsteps", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* selection type: boundingbox or writeblock (whole writer blocks).  */
+          else if (strcmp (long_options[option_index].name, "selection") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->selection_arg), 
+                 &(args_info->selection_orig), &(args_info->selection_given),
+                &(local_args_info.selection_given), optarg, 0, "boundingbox", ARG_STRING,
+                check_ambiguity, override, 0, 0,
+                "selection", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* do not verify the data read.  */
+          else if (strcmp (long_options[option_index].name, "no-verify") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->no_verify_flag), 0, &(args_info->no_verify_given),
+                &(local_args_info.no_verify_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "no-verify", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* verify whole writer blocks by the checksums of writer --checksum instead of every value.  */
+          else if (strcmp (long_options[option_index].name, "checksum") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->checksum_flag), 0, &(args_info->checksum_given),
+                &(local_args_info.checksum_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "checksum", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* threads verifying each read buffer.  */
+          else if (strcmp (long_options[option_index].name, "verify-threads") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->verify_threads_arg), 
+                 &(args_info->verify_threads_orig), &(args_info->verify_threads_given),
+                &(local_args_info.verify_threads_given), optarg, 0, "1", ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "verify-threads", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* for transformed data, first read the stored bytes alone to time I/O apart from decoding.  */
+          else if (strcmp (long_options[option_index].name, "physical") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->physical_flag), 0, &(args_info->physical_given),
+                &(local_args_info.physical_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "physical", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* read the steps of a file as the writer appends them, one at a time, and report the latency from the writer.  */
+          else if (strcmp (long_options[option_index].name, "follow") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->follow_flag), 0, &(args_info->follow_given),
+                &(local_args_info.follow_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "follow", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* drop the file from the page cache of every node before reading (file methods), then read it again warm.  */
+          else if (strcmp (long_options[option_index].name, "cold") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->cold_flag), 0, &(args_info->cold_given),
+                &(local_args_info.cold_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "cold", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* also read the whole writer blocks of each rank as bounding boxes, as writeblocks and a sample as points, timing metadata lookup, scheduling and reads of each.  */
+          else if (strcmp (long_options[option_index].name, "selection-bench") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->selection_bench_flag), 0, &(args_info->selection_bench_given),
+                &(local_args_info.selection_bench_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "selection-bench", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* fraction of the block elements read as random points by --selection-bench.  */
+          else if (strcmp (long_options[option_index].name, "point-frac") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->point_frac_arg), 
+                 &(args_info->point_frac_orig), &(args_info->point_frac_given),
+                &(local_args_info.point_frac_given), optarg, 0, "0.01", ARG_DOUBLE,
+                check_ambiguity, override, 0, 0,
+                "point-frac", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          
+          break;
+        case '?':	/* Invalid option.  */
+          /* `getopt_long' already printed an error message.  */
+          goto failure;
+
+        default:	/* bug: option not considered.  */
+          fprintf (stderr, "%s: option unknown: %c%s\n", CMDLINE_PARSER_PACKAGE, c, (additional_error ? additional_error : ""));
+          abort ();
+        } /* switch */
+    } /* while */
+
+
+
+
+  cmdline_parser_release (&local_args_info);
+
+  if ( error_occurred )
+    return (EXIT_FAILURE);
+
+  if (optind < argc)
+    {
+      int i = 0 ;
+      int found_prog_name = 0;
+      /* whether program name, i.e., argv[0], is in the remaining args
+         (this may happen with some implementations of getopt,
+          but surely not with the one included by gengetopt) */
+
+      i = optind;
+      while (i < argc)
+        if (argv[i++] == argv[0]) {
+          found_prog_name = 1;
+          break;
+        }
+      i = 0;
+
+      args_info->inputs_num = argc - optind - found_prog_name;
+      args_info->inputs =
+        (char **)(malloc ((args_info->inputs_num)*sizeof(char *))) ;
+      while (optind < argc)
+        if (argv[optind++] != argv[0])
+          args_info->inputs[ i++ ] = gengetopt_strdup (argv[optind-1]) ;
+    }
+
+  return 0;
+
+failure:
+  
+  cmdline_parser_release (&local_args_info);
+  return (EXIT_FAILURE);
+}
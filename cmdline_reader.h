@@ -0,0 +1,262 @@
+/** @file cmdline_reader.h
+ *  @brief The header file for the command line option parser
+ *  generated by GNU Gengetopt version 2.22.6
+ *  http://www.gnu.org/software/gengetopt.
+ *  DO NOT modify this file, since it can be overwritten
+ *  @author GNU Gengetopt by Lorenzo Bettini */
+
+#ifndef CMDLINE_READER_H
+#define CMDLINE_READER_H
+
+/* If we use autoconf.  */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h> /* for FILE */
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#ifndef CMDLINE_PARSER_PACKAGE
+/** @brief the program name (used for printing errors) */
+#define CMDLINE_PARSER_PACKAGE "reader"
+#endif
+
+#ifndef CMDLINE_PARSER_PACKAGE_NAME
+/** @brief the complete program name (used for help and version) */
+#define CMDLINE_PARSER_PACKAGE_NAME "reader"
+#endif
+
+#ifndef CMDLINE_PARSER_VERSION
+/** @brief the program version */
+#define CMDLINE_PARSER_VERSION "0.1"
+#endif
+
+/** @brief Where the command line options are stored */
+struct gengetopt_args_info
+{
+  const char *help_help; /**< @brief Print help and exit help description.  */
+  const char *version_help; /**< @brief Print version and exit help description.  */
+  char * decomp_arg;	/**< @brief reader decomposition: even (1D split of gnx) or block (whole writer blocks) (default='even').  */
+  char * decomp_orig;	/**< @brief reader decomposition: even (1D split of gnx) or block (whole writer blocks) original value given at command line.  */
+  const char *decomp_help; /**< @brief reader decomposition: even (1D split of gnx) or block (whole writer blocks) help description.  */
+  int stream_flag;	/**< @brief read one window of steps at a time into two rotating buffers (default=off).  */
+  const char *stream_help; /**< @brief read one window of steps at a time into two rotating buffers help description.  */
+  int window_arg;	/**< @brief number of steps per read in stream mode (default='1').  */
+  char * window_orig;	/**< @brief number of steps per read in stream mode original value given at command line.  */
+  const char *window_help; /**< @brief number of steps per read in stream mode help description.  */
+  char * chunked_arg;	/**< @brief schedule the reads per step (steps) or per selection (blocks), perform them non-blocking and verify and reduce each chunk on a worker thread as it completes.  */
+  char * chunked_orig;	/**< @brief schedule the reads per step (steps) or per selection (blocks), perform them non-blocking and verify and reduce each chunk on a worker thread as it completes original value given at command line.  */
+  const char *chunked_help; /**< @brief schedule the reads per step (steps) or per selection (blocks), perform them non-blocking and verify and reduce each chunk on a worker thread as it completes help description.  */
+  char * results_arg;	/**< @brief write per-step statistics over ranks and the run configuration to FILE (JSON, or CSV for a .csv name).  */
+  char * results_orig;	/**< @brief write per-step statistics over ranks and the run configuration to FILE (JSON, or CSV for a .csv name) original value given at command line.  */
+  const char *results_help; /**< @brief write per-step statistics over ranks and the run configuration to FILE (JSON, or CSV for a .csv name) help description.  */
+  char * trace_arg;	/**< @brief write a per-rank timeline of the run to FILE (Chrome trace JSON, for chrome://tracing or Perfetto).  */
+  char * trace_orig;	/**< @brief write a per-rank timeline of the run to FILE (Chrome trace JSON, for chrome://tracing or Perfetto) original value given at command line.  */
+  const char *trace_help; /**< @brief write a per-rank timeline of the run to FILE (Chrome trace JSON, for chrome://tracing or Perfetto) help description.  */
+  int stragglers_flag;	/**< @brief report per-node bandwidth, the slowest node and rank of each phase, a histogram of rank times and persistent stragglers (default=off).  */
+  const char *stragglers_help; /**< @brief report per-node bandwidth, the slowest node and rank of each phase, a histogram of rank times and persistent stragglers help description.  */
+  int ranks_per_node_arg;	/**< @brief treat every N consecutive ranks as a node for --stragglers, to emulate nodes on one (0: shared-memory nodes) (default='0').  */
+  char * ranks_per_node_orig;	/**< @brief treat every N consecutive ranks as a node for --stragglers, to emulate nodes on one (0: shared-memory nodes) original value given at command line.  */
+  const char *ranks_per_node_help; /**< @brief treat every N consecutive ranks as a node for --stragglers, to emulate nodes on one (0: shared-memory nodes) help description.  */
+  int quiet_flag;	/**< @brief do not print per-rank timing lines (default=off).  */
+  const char *quiet_help; /**< @brief do not print per-rank timing lines help description.  */
+  char * readmethod_arg;	/**< @brief ADIOS read method: BP, BP_AGGREGATE, DATASPACES, DIMES, FLEXPATH or ICEE (default='BP').  */
+  char * readmethod_orig;	/**< @brief ADIOS read method: BP, BP_AGGREGATE, DATASPACES, DIMES, FLEXPATH or ICEE original value given at command line.  */
+  const char *readmethod_help; /**< @brief ADIOS read method: BP, BP_AGGREGATE, DATASPACES, DIMES, FLEXPATH or ICEE help description.  */
+  char * rparams_arg;	/**< @brief read method params (default='').  */
+  char * rparams_orig;	/**< @brief read method params original value given at command line.  */
+  const char *rparams_help; /**< @brief read method params help description.  */
+  int verbose_arg;	/**< @brief ADIOS read method verbosity (default='3').  */
+  char * verbose_orig;	/**< @brief ADIOS read method verbosity original value given at command line.  */
+  const char *verbose_help; /**< @brief ADIOS read method verbosity help description.  */
+  double timeout_arg;	/**< @brief seconds to wait for a stream to appear (staging methods) or, with --follow, for its next step (default='60').  */
+  char * timeout_orig;	/**< @brief seconds to wait for a stream to appear (staging methods) or, with --follow, for its next step original value given at command line.  */
+  const char *timeout_help; /**< @brief seconds to wait for a stream to appear (staging methods) or, with --follow, for its next step help description.  */
+  int first_step_arg;	/**< @brief first step to read (default='0').  */
+  char * first_step_orig;	/**< @brief first step to read original value given at command line.  */
+  const char *first_step_help; /**< @brief first step to read help description.  */
+  int nsteps_arg;	/**< @brief number of steps to read (-1: all from first-step) (default='-1').  */
+  char * nsteps_orig;	/**< @brief number of steps to read (-1: all from first-step) original value given at command line.  */
+  const char *nsteps_help; /**< @brief number of steps to read (-1: all from first-step) help description.  */
+  char * selection_arg;	/**< @brief selection type: boundingbox or writeblock (whole writer blocks) (default='boundingbox').  */
+  char * selection_orig;	/**< @brief selection type: boundingbox or writeblock (whole writer blocks) original value given at command line.  */
+  const char *selection_help; /**< @brief selection type: boundingbox or writeblock (whole writer blocks) help description.  */
+  int no_verify_flag;	/**< @brief do not verify the data read (default=off).  */
+  const char *no_verify_help; /**< @brief do not verify the data read help description.  */
+  int checksum_flag;	/**< @brief verify whole writer blocks by the checksums of writer --checksum instead of every value (default=off).  */
+  const char *checksum_help; /**< @brief verify whole writer blocks by the checksums of writer --checksum instead of every value help description.  */
+  int verify_threads_arg;	/**< @brief threads verifying each read buffer (default='1').  */
+  char * verify_threads_orig;	/**< @brief threads verifying each read buffer original value given at command line.  */
+  const char *verify_threads_help; /**< @brief threads verifying each read buffer help description.  */
+  int physical_flag;	/**< @brief for transformed data, first read the stored bytes alone to time I/O apart from decoding (default=off).  */
+  const char *physical_help; /**< @brief for transformed data, first read the stored bytes alone to time I/O apart from decoding help description.  */
+  int follow_flag;	/**< @brief read the steps of a file as the writer appends them, one at a time, and report the latency from the writer (default=off).  */
+  const char *follow_help; /**< @brief read the steps of a file as the writer appends them, one at a time, and report the latency from the writer help description.  */
+  int cold_flag;	/**< @brief drop the file from the page cache of every node before reading (file methods), then read it again warm (default=off).  */
+  const char *cold_help; /**< @brief drop the file from the page cache of every node before reading (file methods), then read it again warm help description.  */
+  int selection_bench_flag;	/**< @brief also read the whole writer blocks of each rank as bounding boxes, as writeblocks and a sample as points, timing metadata lookup, scheduling and reads of each (default=off).  */
+  const char *selection_bench_help; /**< @brief also read the whole writer blocks of each rank as bounding boxes, as writeblocks and a sample as points, timing metadata lookup, scheduling and reads of each help description.  */
+  double point_frac_arg;	/**< @brief fraction of the block elements read as random points by --selection-bench (default='0.01').  */
+  char * point_frac_orig;	/**< @brief fraction of the block elements read as random points by --selection-bench original value given at command line.  */
+  const char *point_frac_help; /**< @brief fraction of the block elements read as random points by --selection-bench help description.  */
+  
+  unsigned int help_given ;	/**< @brief Whether help was given.  */
+  unsigned int version_given ;	/**< @brief Whether version was given.  */
+  unsigned int decomp_given ;	/**< @brief Whether decomp was given.  */
+  unsigned int stream_given ;	/**< @brief Whether stream was given.  */
+  unsigned int window_given ;	/**< @brief Whether window was given.  */
+  unsigned int chunked_given ;	/**< @brief Whether chunked was given.  */
+  unsigned int results_given ;	/**< @brief Whether results was given.  */
+  unsigned int trace_given ;	/**< @brief Whether trace was given.  */
+  unsigned int stragglers_given ;	/**< @brief Whether stragglers was given.  */
+  unsigned int ranks_per_node_given ;	/**< @brief Whether ranks-per-node was given.  */
+  unsigned int quiet_given ;	/**< @brief Whether quiet was given.  */
+  unsigned int readmethod_given ;	/**< @brief Whether readmethod was given.  */
+  unsigned int rparams_given ;	/**< @brief Whether rparams was given.  */
+  unsigned int verbose_given ;	/**< @brief Whether verbose was given.  */
+  unsigned int timeout_given ;	/**< @brief Whether timeout was given.  */
+  unsigned int first_step_given ;	/**< @brief Whether first-step was given.  */
+  unsigned int nsteps_given ;	/**< @brief Whether nsteps was given.  */
+  unsigned int selection_given ;	/**< @brief Whether selection was given.  */
+  unsigned int no_verify_given ;	/**< @brief Whether no-verify was given.  */
+  unsigned int checksum_given ;	/**< @brief Whether checksum was given.  */
+  unsigned int verify_threads_given ;	/**< @brief Whether verify-threads was given.  */
+  unsigned int physical_given ;	/**< @brief Whether physical was given.  */
+  unsigned int follow_given ;	/**< @brief Whether follow was given.  */
+  unsigned int cold_given ;	/**< @brief Whether cold was given.  */
+  unsigned int selection_bench_given ;	/**< @brief Whether selection-bench was given.  */
+  unsigned int point_frac_given ;	/**< @brief Whether point-frac was given.  */
+
+  char **inputs ; /**< @brief unamed options (options without names) */
+  unsigned inputs_num ; /**< @brief unamed options number */
+} ;
+
+/** @brief The additional parameters to pass to parser functions */
+struct cmdline_parser_params
+{
+  int override; /**< @brief whether to override possibly already present options (default 0) */
+  int initialize; /**< @brief whether to initialize the option structure gengetopt_args_info (default 1) */
+  int check_required; /**< @brief whether to check that all required options were provided (default 1) */
+  int check_ambiguity; /**< @brief whether to check for options already specified in the option structure gengetopt_args_info (default 0) */
+  int print_errors; /**< @brief whether getopt_long should print an error message for a bad option (default 1) */
+} ;
+
+/** @brief the purpose string of the program */
+extern const char *gengetopt_args_info_purpose;
+/** @brief the usage string of the program */
+extern const char *gengetopt_args_info_usage;
+/** @brief the description string of the program */
+extern const char *gengetopt_args_info_description;
+/** @brief all the lines making the help output */
+extern const char *gengetopt_args_info_help[];
+
+/**
+ * The command line parser
+ * @param argc the number of command line options
+ * @param argv the command line options
+ * @param args_info the structure where option information will be stored
+ * @return 0 if everything went fine, NON 0 if an error took place
+ */
+int cmdline_parser (int argc, char **argv,
+  struct gengetopt_args_info *args_info);
+
+/**
+ * The command line parser (version with additional parameters - deprecated)
+ * @param argc the number of command line options
+ * @param argv the command line options
+ * @param args_info the structure where option information will be stored
+ * @param override whether to override possibly already present options
+ * @param initialize whether to initialize the option structure my_args_info
+ * @param check_required whether to check that all required options were provided
+ * @return 0 if everything went fine, NON 0 if an error took place
+ * @deprecated use cmdline_parser_ext() instead
+ */
+int cmdline_parser2 (int argc, char **argv,
+  struct gengetopt_args_info *args_info,
+  int override, int initialize, int check_required);
+
+/**
+ * The command line parser (version with additional parameters)
+ * @param argc the number of command line options
+ * @param argv the command line options
+ * @param args_info the structure where option information will be stored
+ * @param params additional parameters for the parser
+ * @return 0 if everything went fine, NON 0 if an error took place
+ */
+int cmdline_parser_ext (int argc, char **argv,
+  struct gengetopt_args_info *args_info,
+  struct cmdline_parser_params *params);
+
+/**
+ * Save the contents of the option struct into an already open FILE stream.
+ * @param outfile the stream where to dump options
+ * @param args_info the option struct to dump
+ * @return 0 if everything went fine, NON 0 if an error took place
+ */
+int cmdline_parser_dump(FILE *outfile,
+  struct gengetopt_args_info *args_info);
+
+/**
+ * Save the contents of the option struct into a (text) file.
+ * This file can be read by the config file parser (if generated by gengetopt)
+ * @param filename the file where to save
+ * @param args_info the option struct to save
+ * @return 0 if everything went fine, NON 0 if an error took place
+ */
+int cmdline_parser_file_save(const char *filename,
+  struct gengetopt_args_info *args_info);
+
+/**
+ * Print the help
+ */
+void cmdline_parser_print_help(void);
+/**
+ * Print the version
+ */
+void cmdline_parser_print_version(void);
+
+/**
+ * Initializes all the fields a cmdline_parser_params structure 
+ * to their default values
+ * @param params the structure to initialize
+ */
+void cmdline_parser_params_init(struct cmdline_parser_params *params);
+
+/**
+ * Allocates dynamically a cmdline_parser_params structure and initializes
+ * all its fields to their default values
+ * @return the created and initialized cmdline_parser_params structure
+ */
+struct cmdline_parser_params *cmdline_parser_params_create(void);
+
+/**
+ * Initializes the passed gengetopt_args_info structure's fields
+ * (also set default values for options that have a default)
+ * @param args_info the structure to initialize
+ */
+void cmdline_parser_init (struct gengetopt_args_info *args_info);
+/**
+ * Deallocates the string fields of the gengetopt_args_info structure
+ * (but does not deallocate the structure itself)
+ * @param args_info the structure to deallocate
+ */
+void cmdline_parser_free (struct gengetopt_args_info *args_info);
+
+/**
+ * Checks that all the required options were specified
+ * @param args_info the structure to check
+ * @param prog_name the name of the program that will be used to print
+ *   possible errors
+ * @return
+ */
+int cmdline_parser_required (struct gengetopt_args_info *args_info,
+  const char *prog_name);
+
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* CMDLINE_READER_H */
@@ -0,0 +1,154 @@
+/*
+ * Compute phase between output steps.
+ */
+
+#include "compute.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+static const char *kernelNames[] = {"sleep", "stream", "flops", "halo"};
+static const char *kernelUnits[] = {"-", "MB/s", "GFLOP/s", "it/s"};
+
+int kernelByName(const char *name)
+{
+    for (int i = 0; i < (int) (sizeof(kernelNames) / sizeof(kernelNames[0])); i++)
+    {
+        if (strcmp(name, kernelNames[i]) == 0)
+            return i;
+    }
+    return -1;
+}
+
+const char *kernelName(int kernel)
+{
+    return kernelNames[kernel];
+}
+
+const char *kernelUnit(int kernel)
+{
+    return kernelUnits[kernel];
+}
+
+Compute::Compute(int kernel, size_t bytes, size_t halobytes, MPI_Comm comm)
+    : kernel_(kernel), comm_(MPI_COMM_NULL), left_(0), right_(0)
+{
+    if (kernel_ == KERNEL_STREAM || kernel_ == KERNEL_HALO)
+    {
+        // Three arrays, touched here so that the first run does not pay
+        // for the page faults
+        size_t n = std::max((size_t) 1, bytes / 3 / sizeof(double));
+        a_.assign(n, 0.0);
+        b_.assign(n, 1.0);
+        c_.assign(n, 2.0);
+    }
+    if (kernel_ == KERNEL_HALO)
+    {
+        // Own communicator, so that halo messages never match ADIOS ones
+        int rank, nproc;
+        MPI_Comm_dup(comm, &comm_);
+        MPI_Comm_rank(comm_, &rank);
+        MPI_Comm_size(comm_, &nproc);
+        left_ = (rank + nproc - 1) % nproc;
+        right_ = (rank + 1) % nproc;
+        size_t h = std::max((size_t) 1, halobytes / sizeof(double));
+        for (int i = 0; i < 2; i++)
+        {
+            send_[i].assign(h, 0.0);
+            recv_[i].assign(h, 0.0);
+        }
+    }
+}
+
+void Compute::release()
+{
+    if (comm_ != MPI_COMM_NULL)
+        MPI_Comm_free(&comm_);
+}
+
+// One pass of a = b + s*c, returns the bytes moved
+double Compute::triad()
+{
+    const double s = 3.0;
+    double *a = a_.data();
+    const double *b = b_.data(), *c = c_.data();
+    size_t n = a_.size();
+    for (size_t i = 0; i < n; i++)
+        a[i] = b[i] + s * c[i];
+    // Feed the result back so that passes depend on each other
+    std::swap(a_, b_);
+    return 3.0 * sizeof(double) * n;
+}
+
+double Compute::run(double seconds)
+{
+    if (seconds <= 0)
+        return 0.0;
+
+    double t0 = MPI_Wtime(), elapsed = 0.0, work = 0.0;
+    switch (kernel_)
+    {
+    case KERNEL_SLEEP:
+        // usleep may reject a second or more
+        std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+        return 0.0;
+
+    case KERNEL_STREAM:
+        do
+        {
+            work += triad();
+            elapsed = MPI_Wtime() - t0;
+        } while (elapsed < seconds);
+        return work / elapsed / 1024 / 1024;
+
+    case KERNEL_FLOPS:
+    {
+        // Eight independent chains keep the FP units busy; the values stay
+        // bounded since x*m + d converges for m < 1
+        double x[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+        const double m = 0.999999, d = 1e-6;
+        const long chunk = 1 << 20;
+        do
+        {
+            for (long i = 0; i < chunk; i++)
+                for (int k = 0; k < 8; k++)
+                    x[k] = x[k] * m + d;
+            work += 2.0 * 8 * chunk;
+            elapsed = MPI_Wtime() - t0;
+        } while (elapsed < seconds);
+        volatile double sink = 0.0;
+        for (int k = 0; k < 8; k++)
+            sink = sink + x[k];
+        (void) sink;
+        return work / elapsed / 1e9;
+    }
+
+    case KERNEL_HALO:
+    {
+        // Rank 0's clock decides when to stop, so that every rank runs the
+        // same number of exchanges
+        int rank, done = 0;
+        MPI_Comm_rank(comm_, &rank);
+        size_t h = send_[0].size(), n = a_.size();
+        while (!done)
+        {
+            std::copy(a_.begin(), a_.begin() + std::min(h, n), send_[0].begin());
+            std::copy(a_.end() - std::min(h, n), a_.end(), send_[1].begin());
+            MPI_Sendrecv(send_[1].data(), h, MPI_DOUBLE, right_, 0,
+                         recv_[0].data(), h, MPI_DOUBLE, left_, 0, comm_, MPI_STATUS_IGNORE);
+            MPI_Sendrecv(send_[0].data(), h, MPI_DOUBLE, left_, 1,
+                         recv_[1].data(), h, MPI_DOUBLE, right_, 1, comm_, MPI_STATUS_IGNORE);
+            triad();
+            work += 1;
+            elapsed = MPI_Wtime() - t0;
+            done = rank == 0 && elapsed >= seconds;
+            MPI_Allreduce(MPI_IN_PLACE, &done, 1, MPI_INT, MPI_MAX, comm_);
+        }
+        elapsed = MPI_Wtime() - t0;
+        return work / elapsed;
+    }
+    }
+    return 0.0;
+}
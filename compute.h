@@ -0,0 +1,65 @@
+/*
+ * Compute phase between output steps.
+ *
+ * Instead of sleeping, each rank can run a kernel for the interval so that
+ * buffered and asynchronous flushes compete with a solver for CPU, memory
+ * bandwidth and the network, and the kernel's own rate shows how much the
+ * I/O slows the computation down.
+ */
+
+#ifndef COMPUTE_H
+#define COMPUTE_H
+
+#include <cstddef>
+#include <vector>
+#include <mpi.h>
+
+// Kernels:
+//   sleep  - idle, the original sleep between steps
+//   stream - STREAM triad a = b + s*c over the working set (memory bound)
+//   flops  - independent multiply-add chains in registers (compute bound)
+//   halo   - halo exchange with both ring neighbours, a triad sweep and an
+//            allreduce per iteration, as an iterative solver would do
+enum Kernel
+{
+    KERNEL_SLEEP,
+    KERNEL_STREAM,
+    KERNEL_FLOPS,
+    KERNEL_HALO
+};
+
+// Kernel by name, -1 if unknown
+int kernelByName(const char *name);
+const char *kernelName(int kernel);
+
+// Unit of the kernel's rate: MB/s, GFLOP/s or it/s
+const char *kernelUnit(int kernel);
+
+class Compute
+{
+public:
+    // Collective over comm for the halo kernel. bytes is the working set
+    // per rank, halobytes the message to each neighbour.
+    Compute(int kernel, size_t bytes, size_t halobytes, MPI_Comm comm);
+
+    // Collective: frees the halo communicator, before MPI_Finalize
+    void release();
+
+    // Run the kernel for about the given time. Returns the rate in
+    // kernelUnit() units, 0 for sleep. The halo kernel is collective and
+    // all ranks stop at the same iteration.
+    double run(double seconds);
+
+    int kernel() const { return kernel_; }
+
+private:
+    int kernel_;
+    MPI_Comm comm_;
+    int left_, right_;
+    std::vector<double> a_, b_, c_;
+    std::vector<double> send_[2], recv_[2];
+
+    double triad();
+};
+
+#endif /* COMPUTE_H */
@@ -0,0 +1,183 @@
+/*
+ * Burst-buffer drain.
+ */
+
+#include "drain.h"
+#include "fileutil.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+Drain::Drain(const std::string &name, const std::string &dest, bool active, bool append)
+    : name_(name), dest_(dest), active_(active), append_(append), ok_(true), stop_(false),
+      running_(false), busy_(0.0)
+{
+    if (active_)
+        thread_ = std::thread(&Drain::run, this);
+}
+
+Drain::~Drain()
+{
+    if (!active_)
+        return;
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        stop_ = true;
+    }
+    cond_.notify_all();
+    thread_.join();
+}
+
+void Drain::push(int step)
+{
+    if (!active_)
+        return;
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        Step s = {step, 0, 0.0, (int) queue_.size() + (running_ ? 1 : 0)};
+        queue_.push_back(s);
+    }
+    cond_.notify_all();
+}
+
+double Drain::busyTime()
+{
+    std::lock_guard<std::mutex> guard(lock_);
+    if (!running_)
+        return busy_;
+    return busy_ + std::chrono::duration<double>(std::chrono::steady_clock::now() - since_).count();
+}
+
+void Drain::finish()
+{
+    std::unique_lock<std::mutex> guard(lock_);
+    cond_.wait(guard, [&]{ return !running_ && queue_.empty(); });
+}
+
+std::vector<Drain::Step> Drain::steps()
+{
+    std::lock_guard<std::mutex> guard(lock_);
+    return done_;
+}
+
+bool Drain::ok()
+{
+    std::lock_guard<std::mutex> guard(lock_);
+    return ok_;
+}
+
+void Drain::run()
+{
+    while (true)
+    {
+        Step s;
+        {
+            std::unique_lock<std::mutex> guard(lock_);
+            cond_.wait(guard, [&]{ return stop_ || !queue_.empty(); });
+            if (queue_.empty())
+                return;
+            s = queue_.front();
+            queue_.pop_front();
+            running_ = true;
+            since_ = std::chrono::steady_clock::now();
+        }
+
+        s.bytes = drainFiles();
+
+        {
+            std::lock_guard<std::mutex> guard(lock_);
+            s.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - since_).count();
+            busy_ += s.seconds;
+            done_.push_back(s);
+            running_ = false;
+        }
+        cond_.notify_all();
+    }
+}
+
+// Start of the index of a BP file, from the three index offsets in front
+// of the 4-byte version at its end: an append overwrites the index from
+// there on with the new step. Without a valid footer (not a BP file, or
+// one in the middle of a write) the file is unchanged only up to start.
+static int64_t indexStart(int fd, int64_t size, int64_t start)
+{
+    uint64_t offsets[3];
+    if (size < 28 || pread(fd, offsets, sizeof(offsets), size - 28) != sizeof(offsets))
+        return start;
+    if (offsets[0] >= (uint64_t) start && offsets[0] <= offsets[1] && offsets[1] <= offsets[2] &&
+        offsets[2] <= (uint64_t) size - 28)
+        return offsets[0];
+    return start;
+}
+
+// Copy what changed in the output files (size or modification time) since
+// the last pass. A file that grew by an append is copied from where its
+// index started at the previous copy, any other file whole. Only the size seen now is
+// copied, so that a step being appended meanwhile is left for the next
+// pass. Returns the bytes copied.
+uint64_t Drain::drainFiles()
+{
+    std::string base = name_.substr(name_.find_last_of('/') + 1);
+    std::string dir = name_ + ".dir";
+    mkdir(dest_.c_str(), 0755);
+    mkdir((dest_ + "/" + base + ".dir").c_str(), 0755);
+
+    uint64_t bytes = 0;
+    std::vector<char> buf(4 << 20);
+    std::vector<std::string> files = outputFiles(name_.c_str());
+    for (size_t i = 0; i < files.size(); i++)
+    {
+        struct stat st;
+        if (stat(files[i].c_str(), &st) != 0)
+            continue;
+        Copied version = {st.st_size, st.st_mtim.tv_sec * 1000000000LL + st.st_mtim.tv_nsec, 0};
+        auto last = copied_.find(files[i]);
+        if (last != copied_.end() && last->second.size == version.size &&
+            last->second.mtime == version.mtime)
+            continue;
+        // A file that shrank was written anew
+        int64_t from = 0;
+        if (append_ && last != copied_.end() && version.size >= last->second.size)
+            from = last->second.resume;
+
+        std::string target = dest_ + "/";
+        if (files[i].compare(0, dir.size(), dir) == 0)
+            target += base + ".dir" + files[i].substr(dir.size());
+        else
+            target += base;
+
+        int in = open(files[i].c_str(), O_RDONLY);
+        int out = open(target.c_str(), O_WRONLY | O_CREAT | (from == 0 ? O_TRUNC : 0), 0644);
+        bool good = in >= 0 && out >= 0;
+        if (good)
+            version.resume = indexStart(in, version.size, from);
+        for (int64_t pos = from; good && pos < version.size; )
+        {
+            ssize_t n = pread(in, buf.data(), std::min((int64_t) buf.size(), version.size - pos), pos);
+            good = n > 0 && pwrite(out, buf.data(), n, pos) == n;
+            if (good)
+            {
+                pos += n;
+                bytes += n;
+            }
+        }
+        good = good && ftruncate(out, version.size) == 0;
+        if (in >= 0)
+            close(in);
+        if (out >= 0)
+            close(out);
+        if (good)
+        {
+            copied_[files[i]] = version;
+        }
+        else
+        {
+            std::lock_guard<std::mutex> guard(lock_);
+            ok_ = false;
+        }
+    }
+    return bytes;
+}
@@ -0,0 +1,73 @@
+/*
+ * Burst-buffer drain: a background thread copying a finished output from
+ * node-local storage to its final location while the writer goes on.
+ */
+
+#ifndef DRAIN_H
+#define DRAIN_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class Drain
+{
+public:
+    // Copy output name (and its .dir subfiles) into directory dest. An
+    // inactive drain (ranks other than one per node) does nothing. Only
+    // the steps of an appending writer leave the start of files in place.
+    Drain(const std::string &name, const std::string &dest, bool active, bool append);
+    ~Drain();
+
+    // Step closed: copy what changed in the files since the last drain
+    void push(int step);
+
+    // Seconds spent copying so far, the copy in progress included
+    double busyTime();
+
+    // Wait until everything pushed is copied
+    void finish();
+
+    // Per pushed step: bytes copied (those the step added, and the index
+    // it rewrote), copy time, steps queued ahead of it
+    struct Step
+    {
+        int step;
+        uint64_t bytes;
+        double seconds;
+        int backlog;
+    };
+    std::vector<Step> steps();
+
+    // False if a file could not be copied
+    bool ok();
+
+private:
+    std::string name_, dest_;
+    bool active_, append_, ok_, stop_, running_;
+    double busy_;
+    std::chrono::steady_clock::time_point since_;
+    std::thread thread_;
+    std::mutex lock_;
+    std::condition_variable cond_;
+    std::deque<Step> queue_;
+    std::vector<Step> done_;
+    // Copied version of a file and where the next copy resumes
+    struct Copied
+    {
+        int64_t size, mtime;   // mtime in ns
+        int64_t resume;
+    };
+    std::map<std::string, Copied> copied_;
+
+    void run();
+    uint64_t drainFiles();
+};
+
+#endif /* DRAIN_H */
@@ -0,0 +1,162 @@
+/*
+ * Output file helpers for the benchmark.
+ */
+
+#include "fileutil.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <map>
+#include <sstream>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+std::vector<std::string> outputFiles(const char *name)
+{
+    std::vector<std::string> files;
+    struct stat st;
+    if (stat(name, &st) == 0 && S_ISREG(st.st_mode))
+        files.push_back(name);
+
+    std::string dirname = std::string(name) + ".dir";
+    DIR *dir = opendir(dirname.c_str());
+    if (dir == NULL)
+        return files;
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL)
+    {
+        std::string path = dirname + "/" + entry->d_name;
+        if (stat(path.c_str(), &st) == 0 && S_ISREG(st.st_mode))
+            files.push_back(path);
+    }
+    closedir(dir);
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+uint64_t outputBytes(const char *name)
+{
+    uint64_t bytes = 0;
+    std::vector<std::string> files = outputFiles(name);
+    struct stat st;
+    for (size_t i = 0; i < files.size(); i++)
+        if (stat(files[i].c_str(), &st) == 0)
+            bytes += st.st_size;
+    return bytes;
+}
+
+uint64_t outputBytesAll(const char *name, MPI_Comm leaders)
+{
+    // "path size" per line from every leader
+    std::string list;
+    std::vector<std::string> files = outputFiles(name);
+    struct stat st;
+    for (size_t i = 0; i < files.size(); i++)
+        if (stat(files[i].c_str(), &st) == 0)
+            list += files[i] + " " + std::to_string((unsigned long long) st.st_size) + "\n";
+
+    int rank, nleaders;
+    MPI_Comm_rank(leaders, &rank);
+    MPI_Comm_size(leaders, &nleaders);
+    int len = list.size();
+    std::vector<int> lens(rank == 0 ? nleaders : 0), displs(lens.size(), 0);
+    MPI_Gather(&len, 1, MPI_INT, lens.data(), 1, MPI_INT, 0, leaders);
+    for (size_t k = 1; k < lens.size(); k++)
+        displs[k] = displs[k - 1] + lens[k - 1];
+    std::string all(rank == 0 ? displs.back() + lens.back() : 0, '\0');
+    MPI_Gatherv(&list[0], len, MPI_CHAR, &all[0], lens.data(), displs.data(), MPI_CHAR,
+                0, leaders);
+    if (rank != 0)
+        return 0;
+
+    // Largest size seen of each file
+    std::map<std::string, uint64_t> sizes;
+    std::istringstream in(all);
+    std::string path;
+    unsigned long long size;
+    while (in >> path >> size)
+        sizes[path] = std::max(sizes[path], (uint64_t) size);
+    uint64_t bytes = 0;
+    for (auto it = sizes.begin(); it != sizes.end(); ++it)
+        bytes += it->second;
+    return bytes;
+}
+
+bool syncOutput(const char *name, int rank, int nproc, std::string &err)
+{
+    auto syncPath = [&err](const std::string &path)
+    {
+        int fd = open(path.c_str(), O_RDONLY);
+        bool ok = fd >= 0 && fsync(fd) == 0;
+        if (!ok && err.empty())
+            err = path + ": " + strerror(errno);
+        if (fd >= 0)
+            close(fd);
+        return ok;
+    };
+
+    bool ok = true;
+    std::vector<std::string> files = outputFiles(name);
+    for (size_t i = rank; i < files.size(); i += nproc)
+        ok = syncPath(files[i]) && ok;
+
+    std::string dirname = std::string(name) + ".dir";
+    struct stat st;
+    if (rank == 0 && stat(dirname.c_str(), &st) == 0)
+        ok = syncPath(dirname) && ok;
+    return ok;
+}
+
+int evictOutput(const char *name)
+{
+    int n = 0;
+    std::vector<std::string> files = outputFiles(name);
+    for (size_t i = 0; i < files.size(); i++)
+    {
+        int fd = open(files[i].c_str(), O_RDONLY);
+        if (fd < 0)
+            continue;
+        fdatasync(fd);
+        if (posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED) == 0)
+            n++;
+        close(fd);
+    }
+    return n;
+}
+
+uint64_t residentBytes(const char *name)
+{
+    const long pagesize = sysconf(_SC_PAGESIZE);
+    uint64_t bytes = 0;
+    std::vector<std::string> files = outputFiles(name);
+    for (size_t i = 0; i < files.size(); i++)
+    {
+        int fd = open(files[i].c_str(), O_RDONLY);
+        if (fd < 0)
+            continue;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+            // Mapping the file does not fault its pages in; mincore tells
+            // which of them are in the page cache
+            void *p = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+            if (p != MAP_FAILED)
+            {
+                std::vector<unsigned char> vec((st.st_size + pagesize - 1) / pagesize);
+                if (mincore(p, st.st_size, vec.data()) == 0)
+                {
+                    for (size_t k = 0; k < vec.size(); k++)
+                        if (vec[k] & 1)
+                            bytes += pagesize;
+                }
+                munmap(p, st.st_size);
+            }
+        }
+        close(fd);
+    }
+    return bytes;
+}
@@ -0,0 +1,40 @@
+/*
+ * Output file helpers for the benchmark: the files of a BP output, their
+ * size, and moving them to storage or out of the page cache.
+ */
+
+#ifndef FILEUTIL_H
+#define FILEUTIL_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <mpi.h>
+
+// An output file and the subfiles in its .dir directory, those that exist
+std::vector<std::string> outputFiles(const char *name);
+
+// Bytes of an output file and of the subfiles in its .dir directory
+uint64_t outputBytes(const char *name);
+
+// Bytes of the output over all nodes, for node-local output: every node
+// leader lists the files it sees, and a file seen by several nodes (on a
+// shared file system) counts once. Collective over leaders (one rank per
+// node); the total is returned on its rank 0, 0 elsewhere.
+uint64_t outputBytesAll(const char *name, MPI_Comm leaders);
+
+// Flush the output files this node sees to storage, spread round-robin
+// over the nproc ranks of the node. Its rank 0 also flushes the .dir
+// directory, whose entries are metadata too. False, with the file and the
+// reason in err, if something could not be synced.
+bool syncOutput(const char *name, int rank, int nproc, std::string &err);
+
+// Drop the pages of the output files from the page cache of this node
+// (written back first, since only clean pages can be dropped). Returns the
+// number of files evicted.
+int evictOutput(const char *name);
+
+// Bytes of the output files resident in the page cache of this node
+uint64_t residentBytes(const char *name);
+
+#endif /* FILEUTIL_H */
@@ -0,0 +1,156 @@
+/*
+ * Per-node and straggler analysis of per-rank timings.
+ */
+
+#include "hoststats.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+HostStats::HostStats(MPI_Comm comm, const Topology &topo)
+    : comm_(comm), hosts_(topo.hosts()), node_(topo.nodeOf())
+{
+    MPI_Comm_rank(comm_, &rank_);
+    MPI_Comm_size(comm_, &nproc_);
+}
+
+void HostStats::add(const std::vector<std::string> &phases, const double *values, uint64_t bytes)
+{
+    int n = phases.size();
+    std::vector<double> all(rank_ == 0 ? n * nproc_ : 0);
+    std::vector<uint64_t> allbytes(rank_ == 0 ? nproc_ : 0);
+    MPI_Gather((void *) values, n, MPI_DOUBLE, all.data(), n, MPI_DOUBLE, 0, comm_);
+    MPI_Gather(&bytes, 1, MPI_UINT64_T, allbytes.data(), 1, MPI_UINT64_T, 0, comm_);
+    if (rank_ != 0)
+        return;
+
+    phases_ = phases;
+    values_.push_back(all);
+    bytes_.push_back(allbytes);
+}
+
+void HostStats::report() const
+{
+    if (rank_ != 0 || values_.empty())
+        return;
+
+    const int n = phases_.size();
+    const int nsteps = values_.size();
+    const int nnodes = hosts_.size();
+    int total = std::find(phases_.begin(), phases_.end(), "total") - phases_.begin();
+    if (total == n)
+        total = n - 1;
+
+    // Per node: bytes, the time of its slowest rank summed over steps, and
+    // the steps in which it held the slowest rank
+    std::vector<uint64_t> nodebytes(nnodes, 0);
+    std::vector<double> nodetime(nnodes, 0.0);
+    std::vector<int> nodeslowest(nnodes, 0), noderanks(nnodes, 0);
+    for (int r = 0; r < nproc_; r++)
+        noderanks[node_[r]]++;
+
+    // Per rank: mean time of each phase, and the steps in which it was in
+    // the slowest tenth (at least the slowest rank)
+    std::vector<double> mean(nproc_ * n, 0.0);
+    std::vector<int> straggled(nproc_, 0);
+    const int top = std::max(1, (nproc_ + 9) / 10);
+    for (int s = 0; s < nsteps; s++)
+    {
+        const std::vector<double> &v = values_[s];
+        std::vector<double> steptime(nnodes, 0.0);
+        for (int r = 0; r < nproc_; r++)
+        {
+            nodebytes[node_[r]] += bytes_[s][r];
+            steptime[node_[r]] = std::max(steptime[node_[r]], v[r * n + total]);
+            for (int i = 0; i < n; i++)
+                mean[r * n + i] += v[r * n + i] / nsteps;
+        }
+        for (int k = 0; k < nnodes; k++)
+            nodetime[k] += steptime[k];
+
+        std::vector<int> order(nproc_);
+        for (int r = 0; r < nproc_; r++)
+            order[r] = r;
+        std::sort(order.begin(), order.end(), [&](int a, int b) {
+            return v[a * n + total] > v[b * n + total];
+        });
+        for (int k = 0; k < top; k++)
+            straggled[order[k]]++;
+        nodeslowest[node_[order[0]]]++;
+    }
+
+    printf("\n>>> %5s %5s %-24s %5s %12s %9s %9s\n",
+           "", "node", "host", "ranks", "(MB/s)", "time(s)", "slowest");
+    for (int k = 0; k < nnodes; k++)
+        printf(">>> %5s %5d %-24s %5d %12.03f %9.03f %8.0f%%\n",
+               "NODE", k, hosts_[k].c_str(), noderanks[k],
+               nodetime[k] > 0 ? (float) nodebytes[k] / nodetime[k] / 1024 / 1024 : 0.0,
+               nodetime[k], 100.0 * nodeslowest[k] / nsteps);
+
+    // Slowest node (by the mean time of its slowest rank) and rank in each
+    // phase, against the median rank
+    printf("\n>>> %5s %-10s %5s %9s %5s %9s %9s\n",
+           "", "phase", "node", "time(s)", "rank", "time(s)", "median");
+    for (int i = 0; i < n; i++)
+    {
+        std::vector<double> nodemax(nnodes, 0.0), ranks(nproc_);
+        int slowrank = 0;
+        for (int r = 0; r < nproc_; r++)
+        {
+            ranks[r] = mean[r * n + i];
+            nodemax[node_[r]] = std::max(nodemax[node_[r]], ranks[r]);
+            if (ranks[r] > ranks[slowrank])
+                slowrank = r;
+        }
+        int slownode = std::max_element(nodemax.begin(), nodemax.end()) - nodemax.begin();
+        std::sort(ranks.begin(), ranks.end());
+        printf(">>> %5s %-10s %5d %9.03f %5d %9.03f %9.03f\n",
+               "SLOW", phases_[i].c_str(), slownode, nodemax[slownode],
+               slowrank, mean[slowrank * n + i], ranks[nproc_ / 2]);
+    }
+
+    // Histogram of the mean total time of the ranks
+    const int nbins = 10;
+    double lo = 1e30, hi = 0.0;
+    for (int r = 0; r < nproc_; r++)
+    {
+        lo = std::min(lo, mean[r * n + total]);
+        hi = std::max(hi, mean[r * n + total]);
+    }
+    std::vector<int> bins(nbins, 0);
+    for (int r = 0; r < nproc_; r++)
+    {
+        int b = hi > lo ? (int) ((mean[r * n + total] - lo) / (hi - lo) * nbins) : 0;
+        bins[std::min(b, nbins - 1)]++;
+    }
+    int most = *std::max_element(bins.begin(), bins.end());
+    printf("\n>>> %5s %9s %9s %5s\n", "", "from(s)", "to(s)", "ranks");
+    for (int b = 0; b < nbins; b++)
+    {
+        std::string bar(most > 0 ? (bins[b] * 40 + most - 1) / most : 0, '#');
+        printf(">>> %5s %9.03f %9.03f %5d%s%s\n", "HIST",
+               lo + (hi - lo) * b / nbins, lo + (hi - lo) * (b + 1) / nbins, bins[b],
+               bar.empty() ? "" : " ", bar.c_str());
+    }
+
+    // Persistent stragglers: share of steps in the slowest tenth. Spread
+    // over many ranks points at the method, concentrated on the ranks of
+    // one node at that node.
+    std::vector<int> order(nproc_);
+    for (int r = 0; r < nproc_; r++)
+        order[r] = r;
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return straggled[a] > straggled[b];
+    });
+    printf("\n>>> %5s %5s %-24s %9s %9s\n", "", "rank", "host", "score", "mean(s)");
+    for (int k = 0; k < std::min(nproc_, 5); k++)
+    {
+        int r = order[k];
+        if (straggled[r] == 0)
+            break;
+        printf(">>> %5s %5d %-24s %9.02f %9.03f\n", "STRAG", r, hosts_[node_[r]].c_str(),
+               (double) straggled[r] / nsteps, mean[r * n + total]);
+    }
+    fflush(stdout);
+}
@@ -0,0 +1,43 @@
+/*
+ * Per-node and straggler analysis of per-rank timings.
+ *
+ * Rank 0 collects the phase times and bytes of every rank each step and,
+ * with the node topology, reports per-node bandwidth, the slowest node and rank
+ * in each phase, a histogram of rank times and how persistently ranks
+ * straggle, to tell a bad node or device from a problem of the method.
+ */
+
+#ifndef HOSTSTATS_H
+#define HOSTSTATS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <mpi.h>
+#include "topology.h"
+
+class HostStats
+{
+public:
+    // Nodes and their hosts from the topology of comm
+    HostStats(MPI_Comm comm, const Topology &topo);
+
+    // Collective: gather values[i] of phases[i] and the bytes moved by
+    // each rank in one step. The "total" phase, or the last one, ranks
+    // the ranks.
+    void add(const std::vector<std::string> &phases, const double *values, uint64_t bytes);
+
+    // Print the analysis of the steps added so far on rank 0
+    void report() const;
+
+private:
+    MPI_Comm comm_;
+    int rank_, nproc_;
+    std::vector<std::string> hosts_;   // by node
+    std::vector<int> node_;            // node of each rank
+    std::vector<std::string> phases_;
+    std::vector< std::vector<double> > values_;   // [step][rank * nphases + phase]
+    std::vector< std::vector<uint64_t> > bytes_;  // [step][rank]
+};
+
+#endif /* HOSTSTATS_H */
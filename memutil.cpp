@@ -0,0 +1,127 @@
+/*
+ * Memory footprint helpers for the benchmark.
+ */
+
+#include "memutil.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#include <sys/mman.h>
+
+uint64_t nodeMemory()
+{
+    return (uint64_t) sysconf(_SC_PHYS_PAGES) * sysconf(_SC_PAGESIZE);
+}
+
+long memAvailable()
+{
+    FILE *fp = fopen("/proc/meminfo", "r");
+    if (fp == NULL)
+        return -1;
+
+    char line[256];
+    long kb = -1;
+    while (fgets(line, sizeof(line), fp))
+    {
+        if (sscanf(line, "MemAvailable: %ld kB", &kb) == 1)
+            break;
+    }
+    fclose(fp);
+    return kb;
+}
+
+// Field of /proc/self/status in kB
+static long procStatus(const char *key)
+{
+    FILE *fp = fopen("/proc/self/status", "r");
+    if (fp == NULL)
+        return -1;
+
+    char line[256];
+    size_t len = strlen(key);
+    long kb = -1;
+    while (fgets(line, sizeof(line), fp))
+    {
+        if (strncmp(line, key, len) == 0 && line[len] == ':')
+        {
+            kb = atol(line + len + 1);
+            break;
+        }
+    }
+    fclose(fp);
+    return kb;
+}
+
+long residentSize()
+{
+    return procStatus("VmRSS");
+}
+
+long peakResident()
+{
+    return procStatus("VmHWM");
+}
+
+bool resetPeakResident()
+{
+    FILE *fp = fopen("/proc/self/clear_refs", "w");
+    if (fp == NULL)
+        return false;
+    bool ok = fputs("5", fp) >= 0;
+    return fclose(fp) == 0 && ok;
+}
+
+void *allocBallast(size_t bytes, bool thp)
+{
+    if (bytes == 0)
+        return NULL;
+
+    size_t align = thp ? 2 * 1024 * 1024 : sysconf(_SC_PAGESIZE);
+    void *buf = NULL;
+    if (posix_memalign(&buf, align, bytes) != 0)
+        return NULL;
+#ifdef MADV_HUGEPAGE
+    if (thp)
+        madvise(buf, bytes, MADV_HUGEPAGE);
+#endif
+    return buf;
+}
+
+bool isTouchPattern(const char *pattern)
+{
+    return strcmp(pattern, "none") == 0 || strcmp(pattern, "memset") == 0
+        || strcmp(pattern, "page") == 0 || strcmp(pattern, "random") == 0;
+}
+
+void touchBallast(void *buf, size_t bytes, const char *pattern, unsigned seed)
+{
+    if (buf == NULL)
+        return;
+
+    if (strcmp(pattern, "memset") == 0)
+    {
+        memset(buf, '\0', bytes);
+    }
+    else if (strcmp(pattern, "page") == 0)
+    {
+        size_t pagesize = sysconf(_SC_PAGESIZE);
+        char *p = (char *) buf;
+        for (size_t i = 0; i < bytes; i += pagesize)
+            p[i] = (char) (i / pagesize + seed);
+    }
+    else if (strcmp(pattern, "random") == 0)
+    {
+        // xorshift64, a different stream per seed
+        uint64_t v = 0x9E3779B97F4A7C15ULL ^ ((uint64_t) seed << 32 | seed);
+        uint64_t *p = (uint64_t *) buf;
+        for (size_t i = 0; i < bytes / sizeof(uint64_t); i++)
+        {
+            v ^= v << 13;
+            v ^= v >> 7;
+            v ^= v << 17;
+            p[i] = v;
+        }
+    }
+}
@@ -0,0 +1,42 @@
+/*
+ * Memory footprint helpers for the benchmark: node memory, free memory and
+ * a ballast buffer emulating the resident memory of an application.
+ */
+
+#ifndef MEMUTIL_H
+#define MEMUTIL_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Physical memory of this node in bytes
+uint64_t nodeMemory();
+
+// MemAvailable of this node in kB from /proc/meminfo, -1 if unknown
+long memAvailable();
+
+// Resident set of this process in kB from /proc/self/status: the current
+// size (VmRSS) and its high-water mark (VmHWM), -1 if unknown
+long residentSize();
+long peakResident();
+
+// Reset the high-water mark to the current resident set (Linux 4.0 and
+// later), so that the next peakResident() covers only what follows.
+// False if not supported: the peak then covers the whole run.
+bool resetPeakResident();
+
+// Allocate a page-aligned ballast of the given size. With thp the buffer
+// is 2 MB aligned and advised to use transparent huge pages.
+void *allocBallast(size_t bytes, bool thp);
+
+// Ballast touch patterns:
+//   none   - leave untouched (virtual only)
+//   memset - zero the whole buffer
+//   page   - write one byte per page
+//   random - fill with pseudo-random data (not compressible, not shareable)
+bool isTouchPattern(const char *pattern);
+
+// Make the ballast resident with one of the patterns above
+void touchBallast(void *buf, size_t bytes, const char *pattern, unsigned seed);
+
+#endif /* MEMUTIL_H */
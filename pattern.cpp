@@ -0,0 +1,267 @@
+/*
+ * Data patterns of the benchmark: generation and verification.
+ */
+
+#include "pattern.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+// Ranges below this many elements per thread are not worth a thread
+static const uint64_t minChunk = 1 << 20;
+
+// Number of slices for n elements on at most nthreads threads
+static int numSlices(uint64_t n, int nthreads)
+{
+    return (int) std::max<uint64_t>(1, std::min<uint64_t>(nthreads, n / minChunk));
+}
+
+// Run fn(t, lo, hi) over the slices of [0, n), slice 0 on this thread
+template <typename Fn>
+static void splitRange(uint64_t n, int nt, Fn fn)
+{
+    std::vector<std::thread> threads;
+    for (int t = 1; t < nt; t++)
+        threads.push_back(std::thread(fn, t, n * t / nt, n * (t + 1) / nt));
+    fn(0, 0, n / nt);
+    for (size_t t = 0; t < threads.size(); t++)
+        threads[t].join();
+}
+
+static const char *patternNames[] = {"ramp", "constant", "random", "smooth", "sparse"};
+
+int patternByName(const char *name)
+{
+    for (int i = 0; i < (int) (sizeof(patternNames) / sizeof(patternNames[0])); i++)
+        if (strcmp(name, patternNames[i]) == 0)
+            return i;
+    return -1;
+}
+
+const char *patternName(int pattern)
+{
+    return patternNames[pattern];
+}
+
+// splitmix64 finalizer: a cheap, well mixed hash of the global index
+static inline uint64_t mix(uint64_t z)
+{
+    z += 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+// Generators of one step: value at position p. Integer only, so writer and
+// reader agree bit for bit on any machine.
+struct Constant
+{
+    int v;
+    int operator()(uint64_t) const { return v; }
+};
+
+struct Random
+{
+    uint64_t base;
+    int operator()(uint64_t p) const { return (int) (uint32_t) mix(base + p); }
+};
+
+struct Smooth
+{
+    uint64_t base, shift;
+    int operator()(uint64_t p) const
+    {
+        uint64_t t = (p + shift) & 4095;
+        uint64_t tri = t < 2048 ? t : 4096 - t;
+        return (int) (tri * 256 + (mix(base + p) & 0xff));
+    }
+};
+
+struct Sparse
+{
+    uint64_t base;
+    int operator()(uint64_t p) const
+    {
+        uint64_t h = mix(base + p);
+        return (h & 63) == 0 ? (int) ((h >> 32) | 1) : 0;
+    }
+};
+
+int patternValue(int pattern, uint64_t gnx, int step, uint64_t p)
+{
+    uint64_t base = gnx * step;
+    switch (pattern)
+    {
+    case PATTERN_CONSTANT:
+        return Constant{step}(p);
+    case PATTERN_RANDOM:
+        return Random{base}(p);
+    case PATTERN_SMOOTH:
+        return Smooth{base, 64 * (uint64_t) step}(p);
+    case PATTERN_SPARSE:
+        return Sparse{base}(p);
+    default:
+        return (int) ((base + p) % INT_MAX);
+    }
+}
+
+// The ramp only wraps at INT_MAX, so both loops run on a plain counter
+// between wraps instead of a modulo per element
+static void fillRamp(int *x, uint64_t n, uint64_t first)
+{
+    uint64_t v = first % INT_MAX;
+    uint64_t i = 0;
+    while (i < n)
+    {
+        uint64_t len = std::min(n - i, (uint64_t) INT_MAX - v);
+        int *p = x + i;
+        int base = (int) v;
+        for (uint64_t j = 0; j < len; j++)
+            p[j] = base + (int) j;
+        i += len;
+        v += len;
+        if (v == INT_MAX)
+            v = 0;
+    }
+}
+
+// Checks compare blocks of elements without early exit, which the compiler
+// vectorizes, and only look for the mismatch in a bad block
+static const uint64_t checkBlock = 4096;
+
+static uint64_t checkRamp(const int *x, uint64_t n, uint64_t first)
+{
+    uint64_t v = first % INT_MAX;
+    uint64_t i = 0;
+    while (i < n)
+    {
+        uint64_t len = std::min(std::min(checkBlock, n - i), (uint64_t) INT_MAX - v);
+        const int *p = x + i;
+        int base = (int) v;
+        int bad = 0;
+        for (uint64_t j = 0; j < len; j++)
+            bad |= p[j] ^ (base + (int) j);
+        if (bad)
+        {
+            for (uint64_t j = 0; j < len; j++)
+                if (p[j] != base + (int) j)
+                    return i + j;
+        }
+        i += len;
+        v += len;
+        if (v == INT_MAX)
+            v = 0;
+    }
+    return n;
+}
+
+template <typename Gen>
+static void fillWith(int *x, uint64_t n, uint64_t offset, Gen gen)
+{
+    for (uint64_t i = 0; i < n; i++)
+        x[i] = gen(offset + i);
+}
+
+template <typename Gen>
+static uint64_t checkWith(const int *x, uint64_t n, uint64_t offset, Gen gen)
+{
+    for (uint64_t i = 0; i < n; i += checkBlock)
+    {
+        uint64_t len = std::min(checkBlock, n - i);
+        int bad = 0;
+        for (uint64_t j = 0; j < len; j++)
+            bad |= x[i + j] ^ gen(offset + i + j);
+        if (bad)
+        {
+            for (uint64_t j = 0; j < len; j++)
+                if (x[i + j] != gen(offset + i + j))
+                    return i + j;
+        }
+    }
+    return n;
+}
+
+// Serial fill or check of x[0..n) from position offset of the step
+static void fillRange(int *x, uint64_t n, int pattern, uint64_t gnx, int step, uint64_t offset)
+{
+    uint64_t base = gnx * step;
+    switch (pattern)
+    {
+    case PATTERN_CONSTANT:
+        fillWith(x, n, offset, Constant{step});
+        break;
+    case PATTERN_RANDOM:
+        fillWith(x, n, offset, Random{base});
+        break;
+    case PATTERN_SMOOTH:
+        fillWith(x, n, offset, Smooth{base, 64 * (uint64_t) step});
+        break;
+    case PATTERN_SPARSE:
+        fillWith(x, n, offset, Sparse{base});
+        break;
+    default:
+        fillRamp(x, n, base + offset);
+        break;
+    }
+}
+
+static uint64_t checkRange(const int *x, uint64_t n, int pattern, uint64_t gnx, int step, uint64_t offset)
+{
+    uint64_t base = gnx * step;
+    switch (pattern)
+    {
+    case PATTERN_CONSTANT:
+        return checkWith(x, n, offset, Constant{step});
+    case PATTERN_RANDOM:
+        return checkWith(x, n, offset, Random{base});
+    case PATTERN_SMOOTH:
+        return checkWith(x, n, offset, Smooth{base, 64 * (uint64_t) step});
+    case PATTERN_SPARSE:
+        return checkWith(x, n, offset, Sparse{base});
+    default:
+        return checkRamp(x, n, base + offset);
+    }
+}
+
+void fillPattern(int *x, uint64_t n, int pattern, uint64_t gnx, int step,
+        uint64_t offset, int nthreads)
+{
+    splitRange(n, numSlices(n, nthreads), [&](int, uint64_t lo, uint64_t hi)
+    {
+        fillRange(x + lo, hi - lo, pattern, gnx, step, offset + lo);
+    });
+}
+
+uint64_t verifyPattern(const int *x, uint64_t n, int pattern, uint64_t gnx,
+        int step, uint64_t offset, int nthreads)
+{
+    int nt = numSlices(n, nthreads);
+    std::vector<uint64_t> bad(nt, n);
+    splitRange(n, nt, [&](int t, uint64_t lo, uint64_t hi)
+    {
+        uint64_t k = checkRange(x + lo, hi - lo, pattern, gnx, step, offset + lo);
+        if (k < hi - lo)
+            bad[t] = lo + k;
+    });
+    return *std::min_element(bad.begin(), bad.end());
+}
+
+uint64_t patternChecksum(const int *x, uint64_t n, int nthreads)
+{
+    int nt = numSlices(n, nthreads);
+    std::vector<uint64_t> part(nt, 0);
+    splitRange(n, nt, [&](int t, uint64_t lo, uint64_t hi)
+    {
+        uint64_t sum = 0;
+        for (uint64_t i = lo; i < hi; i++)
+            sum += (uint64_t) (uint32_t) x[i] * (2 * i + 1);
+        part[t] = sum;
+    });
+    uint64_t sum = 0;
+    for (size_t t = 0; t < part.size(); t++)
+        sum += part[t];
+    return sum;
+}
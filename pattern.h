@@ -0,0 +1,52 @@
+/*
+ * Data patterns of the benchmark: generation and verification.
+ *
+ * Every pattern is a pure function of the step and the global position in
+ * the gnx-long array, so any selection of any step can be regenerated and
+ * checked by the reader. The reader can also compare a checksum of each
+ * writer block with the one the writer stored next to the data. All of
+ * these work in place and split large ranges over threads.
+ */
+
+#ifndef PATTERN_H
+#define PATTERN_H
+
+#include <cstdint>
+
+// Data patterns:
+//   ramp     - (gnx*step + position) % INT_MAX, the original ramp
+//   constant - the step number everywhere
+//   random   - uniform 32-bit hash of step and position (incompressible)
+//   smooth   - triangle wave along the array, moving with the step, plus
+//              8 bits of noise
+//   sparse   - random values at about 1 in 64 positions, zero elsewhere
+enum Pattern
+{
+    PATTERN_RAMP,
+    PATTERN_CONSTANT,
+    PATTERN_RANDOM,
+    PATTERN_SMOOTH,
+    PATTERN_SPARSE
+};
+
+// Pattern by name, -1 if unknown
+int patternByName(const char *name);
+const char *patternName(int pattern);
+
+// Value at position p of the given step
+int patternValue(int pattern, uint64_t gnx, int step, uint64_t p);
+
+// Fill x[0..n) with positions offset.. of the given step
+void fillPattern(int *x, uint64_t n, int pattern, uint64_t gnx, int step,
+        uint64_t offset, int nthreads);
+
+// Index of the first element of x[0..n) that differs from positions
+// offset.. of the given step, or n when all match
+uint64_t verifyPattern(const int *x, uint64_t n, int pattern, uint64_t gnx,
+        int step, uint64_t offset, int nthreads);
+
+// Position-weighted 64-bit checksum of x[0..n), sensitive to both the
+// values and their order
+uint64_t patternChecksum(const int *x, uint64_t n, int nthreads);
+
+#endif /* PATTERN_H */
@@ -8,49 +8,234 @@
 //#include <memory>
 //#include <stdexcept>
 #include <string>
+#include <cstring>
+#include <strings.h>
 #include <vector>
+#include <algorithm>
 #include <mpi.h>
 #include <adios_read.h>
 #include <climits>
+#include <dirent.h>
+#include <sys/resource.h>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <random>
+#include "cmdline_reader.h"
+#include "results.h"
+#include "fileutil.h"
+#include "trace.h"
+#include "hoststats.h"
+#include "topology.h"
+#include "pattern.h"
 
-void printData(std::vector<int> x, int steps, uint64_t nelems,
-        uint64_t offset, int rank);
-void summarizeData(std::vector<int> x, unsigned long gnx,  int steps, uint64_t nelems,
+// Checksums stored by writer --checksum, one per writer and step, with the
+// writer block layout (the same in every step)
+struct BlockSums
+{
+    int firststep, nwriters;
+    std::vector<uint64_t> start, count;   // by writer rank
+    std::vector<uint64_t> sums;           // [step - firststep][writer]
+};
+
+// One scheduled read of chunked mode: steps of selection sel from first,
+// at data
+struct Chunk
+{
+    size_t sel;
+    int first, steps;
+    const int *data;
+};
+
+// How reads are verified: the data pattern, the threads to use and the
+// writer checksums (NULL to check every value)
+struct Verify
+{
+    int pattern;
+    int nthreads;
+    const BlockSums *sums;
+};
+
+// Cost of reading through one selection type: metadata lookup,
+// selection and scheduling, and the reads themselves
+struct SelTiming
+{
+    double meta, schedule, perform;
+    uint64_t elements;
+    int errors;
+};
+
+void printData(const int *x, int steps, uint64_t nelems,
         uint64_t offset, int rank);
+void summarizeData(const int *x, unsigned long gnx,  int steps, uint64_t nelems,
+        uint64_t offset, int rank, int firststep, const Verify &v);
+void verifySelections(const std::vector<int> &x, unsigned long gnx, int steps,
+        const std::vector<uint64_t> &selstart, const std::vector<uint64_t> &selcount,
+        int rank, int firststep, const Verify &v);
+int countSubfiles(const char *inputfile);
+int subfileOf(uint32_t pid, int nwriters, int nsubfiles);
+SelTiming benchSelection(ADIOS_FILE *f, const std::string &type, const std::vector<int> &blocks,
+        const std::vector<uint64_t> &start, const std::vector<uint64_t> &count,
+        const std::vector<uint64_t> &points, int firststep, int nsteps, unsigned long gnx,
+        bool verify, const Verify &v, MPI_Comm comm);
+void assignBlocks(const ADIOS_VARINFO *vi, int nwriters, int nsubfiles,
+        int nproc, int rank, std::vector<int> &blocks);
+
+// ADIOS read methods by name. File methods can read any step range,
+// staging methods only see the current step of a stream.
+struct ReadMethod
+{
+    const char *name;
+    enum ADIOS_READ_METHOD method;
+    bool file;
+};
+
+static const ReadMethod readMethods[] = {
+    {"BP", ADIOS_READ_METHOD_BP, true},
+    {"BP_AGGREGATE", ADIOS_READ_METHOD_BP_AGGREGATE, true},
+    {"DATASPACES", ADIOS_READ_METHOD_DATASPACES, false},
+    {"DIMES", ADIOS_READ_METHOD_DIMES, false},
+    {"FLEXPATH", ADIOS_READ_METHOD_FLEXPATH, false},
+    {"ICEE", ADIOS_READ_METHOD_ICEE, false},
+};
 
 int main(int argc, char *argv[])
 {
     setlinebuf(stdout);    
     int rank = 0, nproc = 1;
-    int namelength;
-    char host[MPI_MAX_PROCESSOR_NAME];
 
-    MPI_Init(&argc, &argv);
+    gengetopt_args_info args_info;
+    if (cmdline_parser (argc, argv, &args_info) != 0)
+        exit(1);
+
+    if (args_info.inputs_num < 1)
+    {
+        cmdline_parser_print_help();
+        exit(1);
+    }
+    const char *inputfile = args_info.inputs[0];
+
+    const std::string decomp = args_info.decomp_arg;
+    if (decomp != "even" && decomp != "block")
+    {
+        std::cout << "Unknown decomposition: " << decomp << "\n";
+        exit(1);
+    }
+    const ReadMethod *rmethod = NULL;
+    for (size_t i = 0; i < sizeof(readMethods) / sizeof(readMethods[0]); i++)
+        if (strcasecmp(args_info.readmethod_arg, readMethods[i].name) == 0)
+            rmethod = &readMethods[i];
+    if (rmethod == NULL)
+    {
+        std::cout << "Unknown read method: " << args_info.readmethod_arg << "\n";
+        exit(1);
+    }
+    const std::string selection = args_info.selection_arg;
+    if (selection != "boundingbox" && selection != "writeblock")
+    {
+        std::cout << "Unknown selection: " << selection << "\n";
+        exit(1);
+    }
+    const bool verify = !args_info.no_verify_flag;
+    const int vthreads = std::max(1, args_info.verify_threads_arg);
+    const bool stream = args_info.stream_flag;
+    const int window = args_info.window_arg;
+    if (window < 1)
+    {
+        std::cout << "Window must be at least 1 step\n";
+        exit(1);
+    }
+    const bool follow = args_info.follow_flag;
+    if (follow && stream)
+    {
+        std::cout << "--follow reads one step at a time and cannot be combined with --stream\n";
+        exit(1);
+    }
+    const std::string chunked = args_info.chunked_given ? args_info.chunked_arg : "";
+    if (!chunked.empty() && chunked != "steps" && chunked != "blocks")
+    {
+        std::cout << "Unknown chunking: " << chunked << "\n";
+        exit(1);
+    }
+    if (!chunked.empty() && (stream || follow))
+    {
+        std::cout << "--chunked reads all steps at once and cannot be combined with --stream or --follow\n";
+        exit(1);
+    }
+    // A file being written is opened as a stream, like a staging method
+    const bool streaming = follow || !rmethod->file;
+    const bool cold = args_info.cold_flag;
+    if (cold && streaming)
+    {
+        std::cout << "--cold needs a file read method and cannot be combined with --follow\n";
+        exit(1);
+    }
+
+    // The streaming reader performs the next read on an I/O thread while
+    // the main thread verifies, and the chunked worker times its processing
+    // while the main thread polls ADIOS. Both threads call MPI, so both
+    // need MPI_THREAD_MULTIPLE.
+    int provided;
+    MPI_Init_thread(&argc, &argv,
+                    stream || !chunked.empty() ? MPI_THREAD_MULTIPLE : MPI_THREAD_SERIALIZED,
+                    &provided);
     MPI_Comm comm = MPI_COMM_WORLD;
     MPI_Comm_rank(comm, &rank);
     MPI_Comm_size(comm, &nproc);
 
-    /* All tasks send their host name to task 0 */
-    char *hostmap = (char*) malloc(nproc * MPI_MAX_PROCESSOR_NAME);
-    MPI_Get_processor_name(host, &namelength);
-    MPI_Gather(&host, MPI_MAX_PROCESSOR_NAME, MPI_CHAR, hostmap,
-             MPI_MAX_PROCESSOR_NAME, MPI_CHAR, 0, MPI_COMM_WORLD);
+    // Node-local and node-leader communicators; rank 0 learns the host of
+    // each node and the node of each rank
+    Topology topo(comm, args_info.ranks_per_node_arg);
 
-    if (argc < 2)
-    {
-        std::cout << "Not enough arguments: need an input file\n";
-        return 1;
-    }
-    const char *inputfile = argv[1];
+    // Run configuration for the results file
+    Results results("reader", comm);
+    char *dump = NULL;
+    size_t dumplen = 0;
+    FILE *dumpfp = open_memstream(&dump, &dumplen);
+    cmdline_parser_dump(dumpfp, &args_info);
+    fclose(dumpfp);
+    results.setConfig(gengetopt_args_info_help, dump);
+    results.addConfig("file", inputfile);
+    free(dump);
+    Trace trace(comm, args_info.trace_given);
+
+    std::string rparams = "verbose=" + std::to_string(args_info.verbose_arg);
+    if (strlen(args_info.rparams_arg) > 0)
+        rparams += std::string(";") + args_info.rparams_arg;
+    adios_read_init_method(rmethod->method, comm, rparams.c_str());
 
-    adios_read_init_method(ADIOS_READ_METHOD_BP, comm, "verbose=3");
+    // Cold cache: one rank per node drops the file from the page cache of
+    // its node, and checks how much of it stayed there
+    MPI_Comm nodecomm;
+    MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &nodecomm);
+    int noderank;
+    MPI_Comm_rank(nodecomm, &noderank);
+    int evicted = 0;
+    uint64_t resident = 0;
+    auto evict = [&]()
+    {
+        if (noderank == 0)
+        {
+            evicted = evictOutput(inputfile);
+            resident = residentBytes(inputfile);
+        }
+        MPI_Barrier(comm);
+    };
+    if (cold)
+        evict();
 
     ADIOS_FILE *f;
     double t[5];
 
     MPI_Barrier(comm);
     t[0] = MPI_Wtime();
-    f = adios_read_open_file(inputfile, ADIOS_READ_METHOD_BP, comm);
+    if (!streaming)
+        f = adios_read_open_file(inputfile, rmethod->method, comm);
+    else
+        f = adios_read_open(inputfile, rmethod->method, comm,
+                            ADIOS_LOCKMODE_ALL, args_info.timeout_arg);
     if (f == NULL)
     {
         std::cout << adios_errmsg() << std::endl;
@@ -58,49 +243,656 @@ int main(int argc, char *argv[])
     }
 
     t[1] = MPI_Wtime();
+    trace.span("open", t[0], t[1]);
     ADIOS_VARINFO *vgnx = adios_inq_var(f, "gnx");
     unsigned long gnx = *(unsigned long *)vgnx->value;
-    int nsteps = vgnx->nsteps;
 
-    // 1D decomposition of the columns, which is inefficient for reading!
-    uint64_t readsize = gnx / nproc;
-    uint64_t offset = rank * readsize;
-    if (rank == nproc - 1)
+    // Step range; a stream only offers its current step, and --follow
+    // takes up to nsteps steps one after the other
+    int firststep = streaming ? 0 : args_info.first_step_arg;
+    int nsteps = vgnx->nsteps - firststep;
+    const int maxsteps = args_info.nsteps_arg >= 0 ? args_info.nsteps_arg : INT_MAX;
+    if (args_info.nsteps_arg >= 0 && args_info.nsteps_arg < nsteps)
+        nsteps = args_info.nsteps_arg;
+    if (firststep < 0 || nsteps <= 0)
     {
-        // last process should read all the rest of columns
-        readsize = gnx - readsize * (nproc - 1);
+        if (rank == 0)
+            printf("No steps to read: first step %d, %d steps available\n",
+                   firststep, vgnx->nsteps);
+        topo.release();
+        MPI_Finalize();
+        return 1;
     }
 
+    // Writer blocks of the first step. Every step is written by the same
+    // writers with the same layout, so step 0 describes the whole file.
+    ADIOS_VARINFO *vx = adios_inq_var(f, "x");
+    adios_inq_var_blockinfo(f, vx);
+    int nwriters = 0;
+    for (int i = 0; i < vx->nblocks[0]; i++)
+        nwriters = std::max(nwriters, (int)vx->blockinfo[i].process_id + 1);
+    int nsubfiles = countSubfiles(inputfile);
+
+    // Writer checksums of the steps to read, fetched up front (8 bytes per
+    // writer and step) so that only the data is timed below
+    BlockSums blocksums;
+    if (verify && args_info.checksum_flag)
+    {
+        ADIOS_VARINFO *vsum = adios_inq_var(f, "xsum");
+        if (vsum == NULL)
+        {
+            if (rank == 0)
+                printf("No block checksums in %s: write it with writer --checksum\n", inputfile);
+            topo.release();
+            MPI_Finalize();
+            return 1;
+        }
+        blocksums.firststep = firststep;
+        blocksums.nwriters = nwriters;
+        blocksums.start.resize(nwriters);
+        blocksums.count.resize(nwriters);
+        for (int i = 0; i < vx->nblocks[0]; i++)
+        {
+            blocksums.start[vx->blockinfo[i].process_id] = vx->blockinfo[i].start[0];
+            blocksums.count[vx->blockinfo[i].process_id] = vx->blockinfo[i].count[0];
+        }
+        blocksums.sums.resize(nsteps * nwriters);
+        uint64_t sstart = 0, scount = nwriters;
+        ADIOS_SELECTION *ssel = adios_selection_boundingbox(1, &sstart, &scount);
+        adios_schedule_read(f, ssel, "xsum", firststep, nsteps, blocksums.sums.data());
+        adios_perform_reads(f, 1);
+        adios_selection_delete(ssel);
+        adios_free_varinfo(vsum);
+    }
+    const BlockSums *sums = args_info.checksum_flag ? &blocksums : NULL;
+
+    // Data pattern recorded by the writer; older files hold the ramp
+    int pattern = PATTERN_RAMP;
+    enum ADIOS_DATATYPES atype;
+    int asize;
+    void *adata;
+    if (adios_get_attr(f, "pattern", &atype, &asize, &adata) == 0)
+    {
+        if (atype == adios_string)
+            pattern = patternByName((char *)adata);
+        free(adata);
+        if (pattern < 0)
+        {
+            if (rank == 0)
+                printf("Unknown data pattern in %s\n", inputfile);
+            topo.release();
+            MPI_Finalize();
+            return 1;
+        }
+    }
+    const Verify vopt = {pattern, vthreads, sums};
+
+    uint64_t readsize = 0;
+    uint64_t offset = 0;
+    // Blocks to read and the whole blocks of this rank, which the
+    // selection benchmark reads
+    std::vector<int> blocks, wholeblocks;
+    if (decomp == "block")
+    {
+        // Whole writer blocks, contiguous in writer rank order and
+        // balanced by bytes
+        assignBlocks(vx, nwriters, nsubfiles, nproc, rank, blocks);
+        for (size_t i = 0; i < blocks.size(); i++)
+            readsize += vx->blockinfo[blocks[i]].count[0];
+        if (blocks.size() > 0)
+            offset = vx->blockinfo[blocks[0]].start[0];
+        wholeblocks = blocks;
+    }
+    else
+    {
+        // 1D decomposition of the columns, which is inefficient for reading!
+        readsize = gnx / nproc;
+        offset = rank * readsize;
+        if (rank == nproc - 1)
+        {
+            // last process should read all the rest of columns
+            readsize = gnx - readsize * (nproc - 1);
+        }
+
+        // Writer blocks overlapping with this slab. Whole-block reads go
+        // to the rank whose slab holds the start of the block instead.
+        for (int i = 0; i < vx->nblocks[0]; i++)
+        {
+            uint64_t start = vx->blockinfo[i].start[0];
+            uint64_t count = vx->blockinfo[i].count[0];
+            if (start >= offset && start < offset + readsize)
+                wholeblocks.push_back(i);
+            if (selection == "writeblock")
+            {
+                if (start >= offset && start < offset + readsize)
+                    blocks.push_back(i);
+            }
+            else if (start < offset + readsize && offset < start + count)
+                blocks.push_back(i);
+        }
+    }
+
+    std::vector<int> files;
+    for (size_t i = 0; i < blocks.size(); i++)
+        files.push_back(subfileOf(vx->blockinfo[blocks[i]].process_id, nwriters, nsubfiles));
+    std::sort(files.begin(), files.end());
+    int nfiles = std::unique(files.begin(), files.end()) - files.begin();
+
     //printf("rank %d reads %d columns from offset %d\n", rank, readsize, offset);
-    std::vector<int> x(nsteps * readsize) ;
 
-    // Create a 2D selection for the subset
-    ADIOS_SELECTION *sel = adios_selection_boundingbox(1, &offset, &readsize);
+    // Create a 1D selection for the subset, or one per writer block.
+    // Writeblock selections always read whole blocks.
+    std::vector<ADIOS_SELECTION *> sels;
+    std::vector<uint64_t> selstart, selcount;
+    if (decomp == "block" || selection == "writeblock")
+    {
+        for (size_t i = 0; i < blocks.size(); i++)
+        {
+            selstart.push_back(vx->blockinfo[blocks[i]].start[0]);
+            selcount.push_back(vx->blockinfo[blocks[i]].count[0]);
+        }
+    }
+    else
+    {
+        selstart.push_back(offset);
+        selcount.push_back(readsize);
+    }
+    readsize = 0;
+    for (size_t i = 0; i < selstart.size(); i++)
+    {
+        if (selection == "writeblock")
+            sels.push_back(adios_selection_writeblock(blocks[i]));
+        else
+            sels.push_back(adios_selection_boundingbox(1, &selstart[i], &selcount[i]));
+        readsize += selcount[i];
+    }
+
+    // Read steps [first, first+steps) into buf, which holds steps x count
+    // for each selection in turn. A writeblock selection covers one step.
+    auto readSteps = [&](int first, int steps, std::vector<int> &buf)
+    {
+        uint64_t pos = 0;
+        for (size_t i = 0; i < sels.size(); i++)
+        {
+            if (selection == "writeblock")
+            {
+                for (int s = 0; s < steps; s++)
+                    adios_schedule_read(f, sels[i], "x", first + s, 1,
+                                        buf.data() + pos + s * selcount[i]);
+            }
+            else
+            {
+                adios_schedule_read(f, sels[i], "x", first, steps, buf.data() + pos);
+            }
+            pos += steps * selcount[i];
+        }
+        adios_perform_reads(f, 1);
+    };
+
+    // Whole run in one buffer, or one window of steps at a time in two
+    // rotating buffers so memory does not grow with nsteps
+    std::vector<int> x;
+    int nwindows = (nsteps + window - 1) / window;
+    std::vector<double> wread(nwindows), wverify(nwindows), wwait(nwindows);
+    // Without MPI_THREAD_MULTIPLE the windows are read in turn
+    bool overlap = provided >= MPI_THREAD_MULTIPLE;
+
+    // A transformed x is first read in the physical view: the stored bytes
+    // of the same writer blocks, which is the I/O part of the logical read
+    // below. The rest of the logical read is decoding.
+    ADIOS_TRANSINFO *ti = adios_inq_var_transinfo(f, vx);
+    const bool transformed = ti != NULL && ti->transform_type != adios_transform_none;
+    adios_free_transinfo(vx, ti);
+    std::string xformname = transformed ? "on" : "none";
+    if (adios_get_attr(f, "transform", &atype, &asize, &adata) == 0)
+    {
+        if (atype == adios_string)
+            xformname = (char *)adata;
+        free(adata);
+    }
+    const bool physical = transformed && args_info.physical_flag && !streaming;
+    uint64_t rawbytes = 0, storedbytes = 0;
+    double tphys = 0.0;
+    if (physical)
+    {
+        adios_read_set_data_view(f, PHYSICAL_DATA_VIEW);
+        ADIOS_VARINFO *vp = adios_inq_var(f, "x");
+        adios_inq_var_blockinfo(f, vp);
+        // Stored sizes differ by step; step s starts at the sum of the
+        // block counts of the earlier steps
+        std::vector<int> stepblock(vp->nsteps, 0);
+        for (int s = 1; s < vp->nsteps; s++)
+            stepblock[s] = stepblock[s - 1] + vp->nblocks[s - 1];
+        // Under the even decomposition two slabs can share a block, which
+        // both ranks read but only the one holding its start counts
+        uint64_t physbytes = 0;
+        for (int s = firststep; s < firststep + nsteps; s++)
+        {
+            for (size_t i = 0; i < blocks.size(); i++)
+                physbytes += vp->blockinfo[stepblock[s] + blocks[i]].count[0];
+            for (size_t i = 0; i < wholeblocks.size(); i++)
+            {
+                storedbytes += vp->blockinfo[stepblock[s] + wholeblocks[i]].count[0];
+                rawbytes += sizeof(int) * vx->blockinfo[wholeblocks[i]].count[0];
+            }
+        }
+
+        std::vector<char> pbuf(physbytes);
+        std::vector<ADIOS_SELECTION *> psels;
+        for (size_t i = 0; i < blocks.size(); i++)
+            psels.push_back(adios_selection_writeblock(blocks[i]));
+        double tp = MPI_Wtime();
+        uint64_t pos = 0;
+        for (int s = firststep; s < firststep + nsteps; s++)
+        {
+            for (size_t i = 0; i < blocks.size(); i++)
+            {
+                adios_schedule_read(f, psels[i], "x", s, 1, pbuf.data() + pos);
+                pos += vp->blockinfo[stepblock[s] + blocks[i]].count[0];
+            }
+        }
+        adios_perform_reads(f, 1);
+        tphys = MPI_Wtime() - tp;
+        trace.span("physical", tp, tp + tphys);
+
+        for (size_t i = 0; i < psels.size(); i++)
+            adios_selection_delete(psels[i]);
+        adios_free_varinfo(vp);
+        adios_read_set_data_view(f, LOGICAL_DATA_VIEW);
+        // The physical pass brought the data into the cache again
+        if (cold)
+            evict();
+    }
+
+    // Per followed step: the step, its read, verification and wait for the
+    // next one, the time since the writer handed it to ADIOS, how many
+    // newer steps were already available, and the writer's timestamp
+    std::vector<int> fstep, flag;
+    std::vector<double> fread, fverify, fwait, flatency, fstamp, fseen;
+
+    // Chunked reads: completed chunks, those matching no request, the
+    // time to the first and the last one, the processing time, the
+    // elements processed against those requested and the reduction of
+    // the data (a sum)
+    int nchunks = 0, unmatched = 0;
+    double tfirst = 0.0, tlast = 0.0, tprocess = 0.0;
+    uint64_t nprocessed = 0, nrequested = 0;
+    int64_t chunksum = 0;
+    const bool chunkworker = provided >= MPI_THREAD_MULTIPLE;
 
-    // Arrays are read by scheduling one or more of them
-    // and performing the reads at once
     t[2] = MPI_Wtime();
-    adios_schedule_read(f, sel, "x", 0, nsteps, x.data());
-    adios_perform_reads(f, 1);
+    trace.span("inquire", t[1], t[2]);
+    if (follow)
+    {
+        x.resize(readsize);
+        uint64_t sstart = 0, scount = nwriters;
+        ADIOS_SELECTION *ssel = adios_selection_boundingbox(1, &sstart, &scount);
+        while ((int) fstep.size() < maxsteps)
+        {
+            int step = f->current_step;
+            if (sums)
+            {
+                adios_schedule_read(f, ssel, "xsum", 0, 1, blocksums.sums.data());
+                adios_perform_reads(f, 1);
+                blocksums.firststep = step;
+            }
+            double tr = MPI_Wtime();
+            readSteps(0, 1, x);
+            fread.push_back(MPI_Wtime() - tr);
+            trace.span("read", tr, tr + fread.back(), step);
+            double seen = wallTime();
+
+            // Writer rank 0 stamped the step; files without it give no latency
+            double stamp = 0.0;
+            ADIOS_VARINFO *vstamp = adios_inq_var(f, "tstep");
+            if (vstamp)
+            {
+                stamp = *(double *)vstamp->value;
+                adios_free_varinfo(vstamp);
+            }
+            fstep.push_back(step);
+            flag.push_back(f->last_step - step);
+            fstamp.push_back(stamp);
+            fseen.push_back(seen);
+            flatency.push_back(stamp > 0 ? seen - stamp : 0.0);
+
+            double tv = MPI_Wtime();
+            if (verify)
+                verifySelections(x, gnx, 1, selstart, selcount, rank, step, vopt);
+            fverify.push_back(MPI_Wtime() - tv);
+            trace.span("verify", tv, tv + fverify.back(), step);
+
+            adios_release_step(f);
+            double tw = MPI_Wtime();
+            int err = 1;
+            if ((int) fstep.size() < maxsteps)
+                err = adios_advance_step(f, 0, args_info.timeout_arg);
+            fwait.push_back(MPI_Wtime() - tw);
+            trace.span("wait", tw, tw + fwait.back(), step);
+
+            // Ranks may see the end of the stream at different times: stop
+            // together so that every rank followed the same steps
+            int stop = err != 0, anystop;
+            MPI_Allreduce(&stop, &anystop, 1, MPI_INT, MPI_MAX, comm);
+            if (anystop)
+                break;
+        }
+        adios_selection_delete(ssel);
+        firststep = fstep[0];
+        nsteps = fstep.size();
+    }
+    else if (!stream && !chunked.empty())
+    {
+        // Non-blocking reads in the layout of readSteps, one request per
+        // step of each selection or per selection, consumed chunk by chunk:
+        // the main thread takes completed chunks from ADIOS while a worker
+        // verifies and reduces the ones before. Chunks are matched to their
+        // request by buffer, so empty selections, which would share one,
+        // are not read.
+        x.resize(nsteps * readsize);
+        std::map<const void *, Chunk> reqs;
+        uint64_t pos = 0;
+        for (size_t i = 0; i < sels.size(); i++)
+        {
+            bool persteps = chunked == "steps" || selection == "writeblock";
+            for (int s = 0; s < (persteps ? nsteps : 1) && selcount[i] > 0; s++)
+            {
+                Chunk c = {i, firststep + s, persteps ? 1 : nsteps,
+                           x.data() + pos + s * selcount[i]};
+                reqs[c.data] = c;
+            }
+            pos += nsteps * selcount[i];
+            nrequested += nsteps * selcount[i];
+        }
+        // By step, so that the first steps of all selections come first
+        std::vector<Chunk> order;
+        for (auto it = reqs.begin(); it != reqs.end(); ++it)
+            order.push_back(it->second);
+        std::stable_sort(order.begin(), order.end(), [](const Chunk &a, const Chunk &b)
+        {
+            return a.first < b.first;
+        });
+        for (size_t k = 0; k < order.size(); k++)
+            adios_schedule_read(f, sels[order[k].sel], "x", order[k].first, order[k].steps,
+                                (void *) order[k].data);
+
+        auto process = [&](const Chunk &c)
+        {
+            double tv = MPI_Wtime();
+            const uint64_t n = c.steps * selcount[c.sel];
+            for (uint64_t k = 0; k < n; k++)
+                chunksum += c.data[k];
+            if (verify)
+                summarizeData(c.data, gnx, c.steps, selcount[c.sel], selstart[c.sel],
+                              rank, c.first, vopt);
+            nprocessed += n;
+            tprocess += MPI_Wtime() - tv;
+            trace.span("process", tv, MPI_Wtime(), c.first);
+        };
+
+        // Without MPI_THREAD_MULTIPLE the main thread processes each chunk
+        // itself before taking the next
+        std::deque<Chunk> ready;
+        std::mutex lock;
+        std::condition_variable cond;
+        bool done = false;
+        std::thread worker;
+        if (chunkworker)
+            worker = std::thread([&]()
+            {
+                while (true)
+                {
+                    Chunk c;
+                    {
+                        std::unique_lock<std::mutex> guard(lock);
+                        cond.wait(guard, [&]{ return !ready.empty() || done; });
+                        if (ready.empty())
+                            return;
+                        c = ready.front();
+                        ready.pop_front();
+                    }
+                    process(c);
+                }
+            });
+
+        adios_perform_reads(f, 0);
+        while (true)
+        {
+            ADIOS_VARCHUNK *chunk = NULL;
+            double tc = MPI_Wtime();
+            int err = adios_check_reads(f, &chunk);
+            if (err < 0)
+            {
+                printf("rank %d: chunked read failed: %s\n", rank, adios_errmsg());
+                break;
+            }
+            if (chunk == NULL)
+            {
+                // All reads done, or none completed yet (staging methods)
+                if (err == 0)
+                    break;
+                continue;
+            }
+            trace.span("check", tc, MPI_Wtime(), chunk->from_steps);
+            if (nchunks++ == 0)
+                tfirst = MPI_Wtime() - t[2];
+            auto it = reqs.find(chunk->data);
+            if (it == reqs.end())
+            {
+                unmatched++;
+            }
+            else if (!chunkworker)
+            {
+                process(it->second);
+            }
+            else
+            {
+                {
+                    std::lock_guard<std::mutex> guard(lock);
+                    ready.push_back(it->second);
+                }
+                cond.notify_all();
+            }
+            adios_free_chunk(chunk);
+        }
+        tlast = MPI_Wtime() - t[2];
+        if (chunkworker)
+        {
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                done = true;
+            }
+            cond.notify_all();
+            worker.join();
+        }
+        // Every requested element must have come in a chunk of its request
+        if (unmatched > 0 || nprocessed != nrequested)
+            printf("rank %d: chunked read ... ERROR: %d unmatched chunks, %llu of %llu elements\n",
+                   rank, unmatched, (unsigned long long) nprocessed,
+                   (unsigned long long) nrequested);
+        trace.span("read", t[2], t[2] + tlast, firststep);
+    }
+    else if (!stream)
+    {
+        // Arrays are read by scheduling one or more of them
+        // and performing the reads at once
+        x.resize(nsteps * readsize);
+        readSteps(firststep, nsteps, x);
+        trace.span("read", t[2], MPI_Wtime(), firststep);
+    }
+    else
+    {
+        std::vector<int> buf[2];
+        buf[0].resize(window * readsize);
+        buf[1].resize(window * readsize);
+
+        auto readWindow = [&](int w)
+        {
+            double tr = MPI_Wtime();
+            readSteps(firststep + w * window, std::min(window, nsteps - w * window), buf[w % 2]);
+            wread[w] = MPI_Wtime() - tr;
+            trace.span("read", tr, tr + wread[w], firststep + w * window);
+        };
+
+        readWindow(0);
+        for (int w = 0; w < nwindows; w++)
+        {
+            // Next window in flight while this one is verified
+            std::thread io;
+            if (w + 1 < nwindows && overlap)
+                io = std::thread(readWindow, w + 1);
+
+            double tv = MPI_Wtime();
+            if (verify)
+                verifySelections(buf[w % 2], gnx, std::min(window, nsteps - w * window),
+                                 selstart, selcount, rank, firststep + w * window, vopt);
+            wverify[w] = MPI_Wtime() - tv;
+            trace.span("verify", tv, tv + wverify[w], firststep + w * window);
+
+            double tw = MPI_Wtime();
+            if (io.joinable())
+                io.join();
+            else if (w + 1 < nwindows)
+                readWindow(w + 1);
+            wwait[w] = MPI_Wtime() - tw;
+            trace.span("wait", tw, tw + wwait[w], firststep + w * window);
+        }
+    }
     t[3] = MPI_Wtime();
 
+    // Warm pass: the same reads again, now from the page cache, timed
+    // apart from the run
+    double twarm = 0.0;
+    if (cold)
+    {
+        MPI_Barrier(comm);
+        double tw = MPI_Wtime();
+        if (stream)
+        {
+            std::vector<int> wbuf(window * readsize);
+            for (int w = 0; w < nwindows; w++)
+                readSteps(firststep + w * window, std::min(window, nsteps - w * window), wbuf);
+        }
+        else
+        {
+            readSteps(firststep, nsteps, x);
+        }
+        twarm = MPI_Wtime() - tw;
+        trace.span("warm", tw, tw + twarm);
+    }
+
+    // Selection benchmark: the whole blocks of this rank read as bounding
+    // boxes and as writeblocks, and a random sample of their elements as
+    // points, each timed by phase
+    const char *seltypes[] = {"boundingbox", "writeblock", "points"};
+    std::vector<SelTiming> seltimes;
+    uint64_t npoints = 0;
+    if (args_info.selection_bench_flag)
+    {
+        std::vector<int> bblocks;
+        std::vector<uint64_t> bstart, bcount;
+        uint64_t belems = 0;
+        for (size_t i = 0; i < wholeblocks.size(); i++)
+        {
+            if (vx->blockinfo[wholeblocks[i]].count[0] == 0)
+                continue;
+            bblocks.push_back(wholeblocks[i]);
+            bstart.push_back(vx->blockinfo[wholeblocks[i]].start[0]);
+            bcount.push_back(vx->blockinfo[wholeblocks[i]].count[0]);
+            belems += bcount.back();
+        }
+        npoints = (uint64_t) (belems * std::max(0.0, std::min(1.0, args_info.point_frac_arg)));
+        std::vector<uint64_t> points(npoints);
+        std::mt19937_64 gen(rank + 1);
+        for (uint64_t k = 0; k < npoints; k++)
+        {
+            uint64_t e = gen() % belems;
+            size_t i = 0;
+            while (e >= bcount[i])
+                e -= bcount[i++];
+            points[k] = bstart[i] + e;
+        }
+        for (int i = 0; i < 3; i++)
+        {
+            double tb = MPI_Wtime();
+            seltimes.push_back(benchSelection(f, seltypes[i], bblocks, bstart, bcount, points,
+                                              firststep, nsteps, gnx, verify, vopt, comm));
+            trace.span(seltypes[i], tb, MPI_Wtime());
+        }
+    }
+
+    double tc = MPI_Wtime();
     adios_read_close(f);
-    t[4] = MPI_Wtime();
+    t[4] = t[3] + MPI_Wtime() - tc;
+    trace.span("close", tc, tc + t[4] - t[3]);
+
+    // Read time without verification, and the decoding part of it
+    double readtime = t[3] - t[2];
+    if (follow)
+    {
+        readtime = 0.0;
+        for (size_t i = 0; i < fread.size(); i++)
+            readtime += fread[i];
+    }
+    if (stream)
+    {
+        readtime = 0.0;
+        for (int w = 0; w < nwindows; w++)
+            readtime += wread[w];
+    }
+    double decode = std::max(0.0, readtime - tphys);
 
     double elap[3];
     elap[0] = t[4] - t[0] - (t[2] - t[1]);
     elap[1] = t[4] - t[2];
     elap[2] = t[4] - t[3];
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    long maxrss;
+    MPI_Reduce(&usage.ru_maxrss, &maxrss, 1, MPI_LONG, MPI_MAX, 0, MPI_COMM_WORLD);
+    int maxevicted;
+    uint64_t maxresident;
+    MPI_Reduce(&evicted, &maxevicted, 1, MPI_INT, MPI_MAX, 0, MPI_COMM_WORLD);
+    MPI_Reduce(&resident, &maxresident, 1, MPI_UINT64_T, MPI_MAX, 0, MPI_COMM_WORLD);
     
     if (rank == 0)
     {
         printf("====== Info =======\n");
         printf("%10s: %lu\n", "gnx", gnx);
         printf("%10s: %d\n", "nsteps", nsteps);
+        printf("%10s: %d..%d\n", "Steps", firststep, firststep + nsteps - 1);
+        printf("%10s: %s\n", "Method", rmethod->name);
+        printf("%10s: %s\n", "Params", rparams.c_str());
+        printf("%10s: %s\n", "Selection", selection.c_str());
+        printf("%10s: %s\n", "Pattern", patternName(pattern));
+        printf("%10s: %s, %d threads\n", "Verify",
+               !verify ? "none" : sums ? "checksum" : "pattern", vthreads);
+        if (transformed)
+            printf("%10s: %s%s\n", "Transform", xformname.c_str(),
+                   physical ? ", physical pass" : "");
         printf("%10s: %d\n", "Total NPs", nproc);
         printf("%10s: %.3f\n", "MBs/proc", (float) sizeof(int)*gnx/nproc/1024/1024);
+        printf("%10s: %s\n", "Decomp", decomp.c_str());
+        printf("%10s: %d\n", "Writers", nwriters);
+        printf("%10s: %d\n", "Subfiles", nsubfiles);
+        if (stream)
+            printf("%10s: %d steps%s\n", "Stream", window,
+                   overlap ? "" : " (no overlap, no MPI_THREAD_MULTIPLE)");
+        if (follow)
+            printf("%10s: %.1f s timeout\n", "Follow", args_info.timeout_arg);
+        if (!chunked.empty())
+            printf("%10s: by %s, non-blocking%s\n", "Chunked", chunked.c_str(),
+                   chunkworker ? "" : ", processed inline (no MPI_THREAD_MULTIPLE)");
+        if (trace.enabled())
+            printf("%10s: %s, clock offsets up to %.1f us\n", "Trace", args_info.trace_arg,
+                   trace.maxOffset() * 1e6);
+        if (cold)
+            printf("%10s: %d files evicted, %.3f MB left in cache (max over nodes)\n",
+                   "Cold", maxevicted, (float) maxresident/1024/1024);
+        printf("%10s: %.3f\n", "MaxRSS(MB)", (float) maxrss/1024);
         for (int i=0; i<nproc; i++)
-            printf("%10s: %5d %s\n", "MAP", i, &hostmap[i*MPI_MAX_PROCESSOR_NAME]);
+            printf("%10s: %5d %s\n", "MAP", i, topo.hosts()[topo.nodeOf()[i]].c_str());
         printf("===================\n\n");
         printf(">>> %5s %9s %12s %9s %12s %9s %12s\n",
                "rank", "t3-t0", "(MB/s)", "t3-t1", "(MB/s)", "t3-t2", "(MB/s)");
@@ -108,11 +900,71 @@ int main(int argc, char *argv[])
     }
     MPI_Barrier(MPI_COMM_WORLD);
     
-    printf(">>> %5d %9.03f %12.03f %9.03f %12.03f %9.03f %12.03f\n",
-            rank, 
-            elap[0], (float)sizeof(int) * nsteps * readsize / elap[0] / 1024 / 1024,
-            elap[1], (float)sizeof(int) * nsteps * readsize / elap[1] / 1024 / 1024,
-            elap[2], (float)sizeof(int) * nsteps * readsize / elap[2] / 1024 / 1024);
+    if (!args_info.quiet_flag)
+        printf(">>> %5d %9.03f %12.03f %9.03f %12.03f %9.03f %12.03f\n",
+                rank, 
+                elap[0], (float)sizeof(int) * nsteps * readsize / elap[0] / 1024 / 1024,
+                elap[1], (float)sizeof(int) * nsteps * readsize / elap[1] / 1024 / 1024,
+                elap[2], (float)sizeof(int) * nsteps * readsize / elap[2] / 1024 / 1024);
+
+    // The whole run is recorded as step -1, stream windows and followed
+    // steps by first step
+    std::vector<std::string> phases = {"open", "inquire", "read", "close", "total"};
+    std::vector<double> phase = {t[1] - t[0], t[2] - t[1] - tphys, t[3] - t[2], t[4] - t[3], elap[0]};
+    uint64_t stored = 0;
+    if (cold)
+    {
+        phases.push_back("warm");
+        phase.push_back(twarm);
+    }
+    if (!chunked.empty())
+    {
+        phases.push_back("first");
+        phase.push_back(tfirst);
+        phases.push_back("process");
+        phase.push_back(tprocess);
+    }
+    for (size_t i = 0; i < seltimes.size(); i++)
+    {
+        phases.push_back(std::string(seltypes[i]) + "-meta");
+        phase.push_back(seltimes[i].meta);
+        phases.push_back(std::string(seltypes[i]) + "-schedule");
+        phase.push_back(seltimes[i].schedule);
+        phases.push_back(std::string(seltypes[i]) + "-perform");
+        phase.push_back(seltimes[i].perform);
+    }
+    if (physical)
+    {
+        phases.push_back("physical");
+        phase.push_back(tphys);
+        phases.push_back("decode");
+        phase.push_back(decode);
+        // Whole run compression ratio applied to the bytes of the run
+        uint64_t sum[2] = {rawbytes, storedbytes}, msum[2];
+        MPI_Allreduce(sum, msum, 2, MPI_UINT64_T, MPI_SUM, comm);
+        if (msum[0] > 0)
+            stored = (uint64_t) ((double) sizeof(int) * nsteps * gnx * msum[1] / msum[0]);
+    }
+    results.gather(-1, phases, phase.data(), sizeof(int) * nsteps * gnx, stored);
+    HostStats hoststats(comm, topo);
+    if (args_info.stragglers_flag)
+        hoststats.add(phases, phase.data(), sizeof(int) * nsteps * readsize);
+    if (stream)
+    {
+        for (int w = 0; w < nwindows; w++)
+        {
+            int steps = std::min(window, nsteps - w * window);
+            double wphase[3] = {wread[w], wverify[w], wwait[w]};
+            results.gather(firststep + w * window, {"read", "verify", "wait"}, wphase,
+                           sizeof(int) * steps * gnx);
+        }
+    }
+    for (int i = 0; i < (int) fstep.size(); i++)
+    {
+        double sphase[4] = {fread[i], fverify[i], fwait[i], flatency[i]};
+        results.gather(fstep[i], {"read", "verify", "wait", "latency"}, sphase,
+                       sizeof(int) * gnx);
+    }
 
     double melap[3];
     MPI_Reduce(elap, melap, 3, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
@@ -128,17 +980,379 @@ int main(int argc, char *argv[])
     }
     MPI_Barrier(MPI_COMM_WORLD);
 
+    if (cold)
+    {
+        // The timed read above ran on a cold cache; the warm pass repeated
+        // it from the page cache
+        double times[2] = {readtime, twarm}, mtimes[2];
+        MPI_Reduce(times, mtimes, 2, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+        if (rank == 0)
+        {
+            printf(">>> %5s %9s %12.03f %9s %12.03f %9s %12.03f %9s %12.03f\n",
+                   "CACHE", "cold(s)", mtimes[0],
+                   "(MB/s)", (float)sizeof(int) * nsteps * gnx / mtimes[0] / 1024 / 1024,
+                   "warm(s)", mtimes[1],
+                   "(MB/s)", (float)sizeof(int) * nsteps * gnx / mtimes[1] / 1024 / 1024);
+            fflush(stdout);
+        }
+    }
+
+    if (!chunked.empty())
+    {
+        // Time to the first chunk and to the last, then the processing and
+        // the part of it left after the last chunk (slowest rank)
+        double times[4] = {tfirst, tlast, tprocess, t[3] - t[2] - tlast}, mtimes[4];
+        int sumchunks;
+        int64_t sum;
+        MPI_Reduce(times, mtimes, 4, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+        MPI_Reduce(&nchunks, &sumchunks, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+        MPI_Reduce(&chunksum, &sum, 1, MPI_INT64_T, MPI_SUM, 0, MPI_COMM_WORLD);
+        if (rank == 0)
+        {
+            printf(">>> %5s %9s %12.03f %9s %12.03f %9s %12.03f %9s %12d\n",
+                   "CHUNK", "first(s)", mtimes[0], "read(s)", mtimes[1],
+                   "(MB/s)", (float)sizeof(int) * nsteps * gnx / mtimes[1] / 1024 / 1024,
+                   "chunks", sumchunks);
+            printf(">>> %5s %9s %12.03f %9s %12.03f %9s %12lld\n",
+                   "CHUNK", "process(s)", mtimes[2], "tail(s)", mtimes[3],
+                   "sum", (long long) sum);
+            fflush(stdout);
+        }
+    }
+
+    if (!seltimes.empty())
+    {
+        // Slowest rank in each phase, elements over all ranks, and the
+        // cost per element of the three phases together
+        if (rank == 0)
+            printf("\n>>> %5s %11s %9s %9s %9s %12s %12s %9s %6s\n", "", "selection",
+                   "meta", "schedule", "perform", "elements", "(MB/s)", "ns/elem", "errors");
+        for (size_t i = 0; i < seltimes.size(); i++)
+        {
+            double times[3] = {seltimes[i].meta, seltimes[i].schedule, seltimes[i].perform}, mtimes[3];
+            uint64_t elements;
+            int errors;
+            MPI_Reduce(times, mtimes, 3, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+            MPI_Reduce(&seltimes[i].elements, &elements, 1, MPI_UINT64_T, MPI_SUM, 0, MPI_COMM_WORLD);
+            MPI_Reduce(&seltimes[i].errors, &errors, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+            if (rank == 0)
+            {
+                double total = mtimes[0] + mtimes[1] + mtimes[2];
+                printf(">>> %5s %11s %9.03f %9.03f %9.03f %12llu %12.03f %9.01f %6d\n",
+                       "SEL", seltypes[i], mtimes[0], mtimes[1], mtimes[2],
+                       (unsigned long long) elements,
+                       total > 0 ? (float) sizeof(int) * elements / total / 1024 / 1024 : 0.0,
+                       elements ? total / elements * 1e9 : 0.0, errors);
+            }
+        }
+        if (rank == 0)
+            fflush(stdout);
+    }
+
+    if (physical)
+    {
+        // Stored bytes and ratio of the blocks read, each counted once, the
+        // physical read and the decoding time of the slowest rank
+        uint64_t bytes[2] = {rawbytes, storedbytes}, mbytes[2];
+        double times[2] = {tphys, decode}, mtimes[2];
+        MPI_Reduce(bytes, mbytes, 2, MPI_UINT64_T, MPI_SUM, 0, MPI_COMM_WORLD);
+        MPI_Reduce(times, mtimes, 2, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+        if (rank == 0)
+        {
+            printf(">>> %5s %9s %12.03f %9s %12.03f %9s %12.03f %9s %12.03f %9s %12.03f\n",
+                   "XFRM", "stored(MB)", (float) mbytes[1]/1024/1024,
+                   "ratio", mbytes[1] ? (float) mbytes[0] / mbytes[1] : 0.0,
+                   "phys(s)", mtimes[0],
+                   "phys(MB/s)", mtimes[0] > 0 ? (float) mbytes[1] / mtimes[0] / 1024 / 1024 : 0.0,
+                   "decode(s)", mtimes[1]);
+            fflush(stdout);
+        }
+    }
+
+    if (stream)
+    {
+        // Per-window latency: read, verification and the part of the next
+        // read that verification could not hide
+        std::vector<double> mread(nwindows), mverify(nwindows), mwait(nwindows);
+        MPI_Reduce(wread.data(), mread.data(), nwindows, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+        MPI_Reduce(wverify.data(), mverify.data(), nwindows, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+        MPI_Reduce(wwait.data(), mwait.data(), nwindows, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+        if (rank == 0)
+        {
+            printf("\n>>> %5s %5s %9s %12s %9s %9s\n",
+                   "", "step", "read", "(MB/s)", "verify", "wait");
+            for (int w = 0; w < nwindows; w++)
+            {
+                int steps = std::min(window, nsteps - w * window);
+                printf(">>> %5s %5d %9.03f %12.03f %9.03f %9.03f\n",
+                       "STEP", firststep + w * window,
+                       mread[w], (float)sizeof(int) * steps * gnx / mread[w] / 1024 / 1024,
+                       mverify[w], mwait[w]);
+            }
+            fflush(stdout);
+        }
+        MPI_Barrier(MPI_COMM_WORLD);
+    }
+
+    if (follow)
+    {
+        // Per-step latency from the writer handing the step to ADIOS to the
+        // slowest rank having read it, and the steps already waiting behind
+        // it. A lag that grows means the reader falls behind; a writer
+        // interval that stretches to the reader's means the reader holds
+        // the writer back.
+        int n = fstep.size();
+        std::vector<double> mread(n), mverify(n), mwait(n), mlatency(n), mseen(n);
+        std::vector<int> mlag(n);
+        MPI_Reduce(fread.data(), mread.data(), n, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+        MPI_Reduce(fverify.data(), mverify.data(), n, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+        MPI_Reduce(fwait.data(), mwait.data(), n, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+        MPI_Reduce(flatency.data(), mlatency.data(), n, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+        MPI_Reduce(fseen.data(), mseen.data(), n, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+        MPI_Reduce(flag.data(), mlag.data(), n, MPI_INT, MPI_MAX, 0, MPI_COMM_WORLD);
+        if (rank == 0)
+        {
+            printf("\n>>> %5s %5s %9s %5s %9s %9s %9s %9s %9s\n",
+                   "", "step", "latency", "lag", "read", "verify", "wait", "w-int", "r-int");
+            double sum = 0.0, mmax = 0.0;
+            int maxlag = 0;
+            for (int i = 0; i < n; i++)
+            {
+                // Interval between steps at the writer and at the reader
+                double wint = i > 0 && fstamp[i - 1] > 0 ? fstamp[i] - fstamp[i - 1] : 0.0;
+                double rint = i > 0 ? mseen[i] - mseen[i - 1] : 0.0;
+                printf(">>> %5s %5d %9.03f %5d %9.03f %9.03f %9.03f %9.03f %9.03f\n",
+                       "LAT", fstep[i], mlatency[i], mlag[i], mread[i], mverify[i], mwait[i],
+                       wint, rint);
+                sum += mlatency[i];
+                mmax = std::max(mmax, mlatency[i]);
+                maxlag = std::max(maxlag, mlag[i]);
+            }
+            printf(">>> %5s %5s %9s %9.03f %9s %9.03f %9s %5d\n",
+                   "LAT", "ALL", "mean(s)", sum / n, "max(s)", mmax, "maxlag", maxlag);
+            fflush(stdout);
+        }
+        MPI_Barrier(MPI_COMM_WORLD);
+    }
+
+    // How many writer blocks and subfiles each rank had to touch
+    int touched[2] = {(int) blocks.size(), nfiles};
+    std::vector<int> alltouched(2 * nproc);
+    MPI_Gather(touched, 2, MPI_INT, alltouched.data(), 2, MPI_INT, 0, MPI_COMM_WORLD);
+    if (rank == 0)
+    {
+        printf("\n### %5s %8s %8s\n", "rank", "blocks", "files");
+        int minmax[4] = {INT_MAX, 0, INT_MAX, 0};
+        for (int i = 0; i < nproc; i++)
+        {
+            printf("### %5d %8d %8d\n", i, alltouched[2*i], alltouched[2*i+1]);
+            minmax[0] = std::min(minmax[0], alltouched[2*i]);
+            minmax[1] = std::max(minmax[1], alltouched[2*i]);
+            minmax[2] = std::min(minmax[2], alltouched[2*i+1]);
+            minmax[3] = std::max(minmax[3], alltouched[2*i+1]);
+        }
+        printf("### %5s %8s %8s\n", "", "min/max", "min/max");
+        char sblocks[32], sfiles[32];
+        snprintf(sblocks, sizeof(sblocks), "%d/%d", minmax[0], minmax[1]);
+        snprintf(sfiles, sizeof(sfiles), "%d/%d", minmax[2], minmax[3]);
+        printf("### %5s %8s %8s\n\n", decomp.c_str(), sblocks, sfiles);
+        fflush(stdout);
+    }
+    hoststats.report();
+    MPI_Barrier(MPI_COMM_WORLD);
+
     //printData(x, nsteps, readsize, offset, rank);
-    summarizeData(x, gnx, nsteps, readsize, offset, rank);
+    if (!stream && !follow && chunked.empty() && verify)
+    {
+        double tv = MPI_Wtime();
+        verifySelections(x, gnx, nsteps, selstart, selcount, rank, firststep, vopt);
+        trace.span("verify", tv, MPI_Wtime(), firststep);
+    }
+    if (args_info.results_given)
+        results.write(args_info.results_arg);
+    if (args_info.trace_given)
+        trace.write(args_info.trace_arg);
+
     adios_free_varinfo(vgnx);
-    adios_selection_delete(sel);
-    adios_read_finalize_method(ADIOS_READ_METHOD_BP);
+    adios_free_varinfo(vx);
+    for (size_t i = 0; i < sels.size(); i++)
+        adios_selection_delete(sels[i]);
+    adios_read_finalize_method(rmethod->method);
+    MPI_Comm_free(&nodecomm);
+    topo.release();
     MPI_Barrier(comm);
     MPI_Finalize();
     return 0;
 }
 
-void printData(std::vector<int> x, int steps, uint64_t nelems,
+// Number of data subfiles (<name>.<N>) under <inputfile>.dir.
+// Without a subfile directory all data lives in the file itself.
+int countSubfiles(const char *inputfile)
+{
+    std::string path = inputfile;
+    std::string dirname = path + ".dir";
+    std::string base = path.substr(path.find_last_of('/') + 1) + ".";
+
+    int n = 0;
+    DIR *dir = opendir(dirname.c_str());
+    if (dir == NULL)
+        return 1;
+    struct dirent *ent;
+    while ((ent = readdir(dir)) != NULL)
+    {
+        std::string name = ent->d_name;
+        if (name.compare(0, base.size(), base) == 0 && name.size() > base.size()
+            && name.find_first_not_of("0123456789", base.size()) == std::string::npos)
+            n++;
+    }
+    closedir(dir);
+    return n > 0 ? n : 1;
+}
+
+// Subfile holding the data of writer rank pid. POSIX writes one subfile
+// per writer; aggregating methods put a contiguous range of writer ranks
+// into each subfile.
+int subfileOf(uint32_t pid, int nwriters, int nsubfiles)
+{
+    if (nwriters <= nsubfiles)
+        return pid;
+    return (int)((uint64_t)pid * nsubfiles / nwriters);
+}
+
+// Assign whole writer blocks of the first step to reader ranks. Blocks are
+// ordered by subfile and writer rank, then cut into nproc contiguous
+// pieces of roughly equal bytes, so that each reader opens as few
+// subfiles as possible. A block goes to the reader owning its midpoint.
+void assignBlocks(const ADIOS_VARINFO *vi, int nwriters, int nsubfiles,
+        int nproc, int rank, std::vector<int> &blocks)
+{
+    int nblocks = vi->nblocks[0];
+    std::vector<int> order(nblocks);
+    for (int i = 0; i < nblocks; i++)
+        order[i] = i;
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        int fa = subfileOf(vi->blockinfo[a].process_id, nwriters, nsubfiles);
+        int fb = subfileOf(vi->blockinfo[b].process_id, nwriters, nsubfiles);
+        if (fa != fb)
+            return fa < fb;
+        if (vi->blockinfo[a].process_id != vi->blockinfo[b].process_id)
+            return vi->blockinfo[a].process_id < vi->blockinfo[b].process_id;
+        return vi->blockinfo[a].start[0] < vi->blockinfo[b].start[0];
+    });
+
+    uint64_t total = 0;
+    for (int i = 0; i < nblocks; i++)
+        total += vi->blockinfo[i].count[0];
+    if (total == 0)
+        return;
+
+    uint64_t sum = 0;
+    for (int i = 0; i < nblocks; i++)
+    {
+        uint64_t count = vi->blockinfo[order[i]].count[0];
+        uint64_t mid = sum + count / 2;
+        int owner = (int)(mid * nproc / total);
+        if (owner == rank)
+            blocks.push_back(order[i]);
+        sum += count;
+    }
+}
+
+// Read the given writer blocks of every step through one selection type:
+// "boundingbox" (start/count of each block), "writeblock" (block index)
+// or "points" (the given global indices). The metadata phase is the
+// lookup the type needs: the variable, and for writeblock where its
+// blocks are. Errors count steps and blocks not matching the pattern.
+SelTiming benchSelection(ADIOS_FILE *f, const std::string &type, const std::vector<int> &blocks,
+        const std::vector<uint64_t> &start, const std::vector<uint64_t> &count,
+        const std::vector<uint64_t> &points, int firststep, int nsteps, unsigned long gnx,
+        bool verify, const Verify &v, MPI_Comm comm)
+{
+    SelTiming st = {0.0, 0.0, 0.0, 0, 0};
+    MPI_Barrier(comm);
+    double t0 = MPI_Wtime();
+    ADIOS_VARINFO *vi = adios_inq_var(f, "x");
+    if (type == "writeblock")
+        adios_inq_var_blockinfo(f, vi);
+    double t1 = MPI_Wtime();
+
+    std::vector<ADIOS_SELECTION *> sels;
+    std::vector<uint64_t> size;
+    if (type == "points")
+    {
+        if (!points.empty())
+        {
+            sels.push_back(adios_selection_points(1, points.size(), points.data()));
+            size.push_back(points.size());
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < blocks.size(); i++)
+        {
+            if (type == "writeblock")
+                sels.push_back(adios_selection_writeblock(blocks[i]));
+            else
+                sels.push_back(adios_selection_boundingbox(1, &start[i], &count[i]));
+            size.push_back(count[i]);
+        }
+    }
+    uint64_t n = 0;
+    for (size_t i = 0; i < size.size(); i++)
+        n += size[i];
+    std::vector<int> buf(nsteps * n);
+    uint64_t pos = 0;
+    for (int s = 0; s < nsteps; s++)
+    {
+        for (size_t i = 0; i < sels.size(); i++)
+        {
+            adios_schedule_read(f, sels[i], "x", firststep + s, 1, buf.data() + pos);
+            pos += size[i];
+        }
+    }
+    double t2 = MPI_Wtime();
+    adios_perform_reads(f, 1);
+    double t3 = MPI_Wtime();
+
+    st.meta = t1 - t0;
+    st.schedule = t2 - t1;
+    st.perform = t3 - t2;
+    st.elements = nsteps * n;
+
+    if (verify)
+    {
+        pos = 0;
+        for (int s = 0; s < nsteps; s++)
+        {
+            int step = firststep + s;
+            if (type == "points")
+            {
+                bool bad = false;
+                for (size_t k = 0; k < points.size(); k++)
+                    bad = bad || buf[pos + k] != patternValue(v.pattern, gnx, step, points[k]);
+                st.errors += bad;
+            }
+            else
+            {
+                uint64_t p = pos;
+                for (size_t i = 0; i < size.size(); i++)
+                {
+                    st.errors += verifyPattern(buf.data() + p, size[i], v.pattern, gnx, step,
+                                               start[i], v.nthreads) != size[i];
+                    p += size[i];
+                }
+            }
+            pos += n;
+        }
+    }
+
+    for (size_t i = 0; i < sels.size(); i++)
+        adios_selection_delete(sels[i]);
+    adios_free_varinfo(vi);
+    return st;
+}
+
+void printData(const int *x, int steps, uint64_t nelems,
         uint64_t offset, int rank)
 {
     std::ofstream myfile;
@@ -176,28 +1390,72 @@ void printData(std::vector<int> x, int steps, uint64_t nelems,
     myfile.close();
 }
 
-void summarizeData(std::vector<int> x, unsigned long gnx,  int steps, uint64_t nelems,
-        uint64_t offset, int rank)
+void verifySelections(const std::vector<int> &x, unsigned long gnx, int steps,
+        const std::vector<uint64_t> &selstart, const std::vector<uint64_t> &selcount,
+        int rank, int firststep, const Verify &v)
+{
+    // Each selection holds steps x count in turn
+    uint64_t pos = 0;
+    for (size_t i = 0; i < selstart.size(); i++)
+    {
+        summarizeData(x.data() + pos, gnx, steps, selcount[i], selstart[i], rank,
+                      firststep, v);
+        pos += steps * selcount[i];
+    }
+}
+
+void summarizeData(const int *x, unsigned long gnx,  int steps, uint64_t nelems,
+        uint64_t offset, int rank, int firststep, const Verify &v)
 {
     for (int step = 0; step < steps; step++)
     {
-        int ok = 1;
-        uint64_t i;
-        for (i = 0; i < nelems; i++)
+        const int *xs = x + step * nelems;
+        const BlockSums *sums = v.sums;
+        if (sums)
         {
-            if (x[step*nelems + i] != (gnx*step + offset + i)%INT_MAX)
+            // Whole writer blocks by checksum, the cut ends of partly
+            // selected blocks by value
+            int bad = -1;
+            uint64_t i = nelems;
+            for (int w = 0; w < sums->nwriters && bad < 0 && i == nelems; w++)
             {
-                ok = 0;
-                break;
+                uint64_t lo = std::max(offset, sums->start[w]);
+                uint64_t hi = std::min(offset + nelems, sums->start[w] + sums->count[w]);
+                if (lo >= hi)
+                    continue;
+                if (hi - lo == sums->count[w])
+                {
+                    uint64_t sum = sums->sums[(firststep + step - sums->firststep) * sums->nwriters + w];
+                    if (patternChecksum(xs + lo - offset, hi - lo, v.nthreads) != sum)
+                        bad = w;
+                }
+                else
+                {
+                    uint64_t k = verifyPattern(xs + lo - offset, hi - lo, v.pattern, gnx,
+                                               firststep + step, lo, v.nthreads);
+                    if (k < hi - lo)
+                        i = lo - offset + k;
+                }
             }
+            if (bad >= 0)
+                printf ("rank: %d step:%d ... ERROR: checksum of block %d\n", rank, firststep+step, bad);
+            else if (i < nelems)
+                printf ("rank: %d step:%d ... ERROR: %d %d\n", rank, firststep+step, xs[i],
+                        patternValue(v.pattern, gnx, firststep + step, offset + i));
+            else
+                printf ("rank: %d step:%d ... PASS\n", rank, firststep+step);
+            continue;
         }
-        if (ok)
+
+        uint64_t i = verifyPattern(xs, nelems, v.pattern, gnx, firststep + step, offset, v.nthreads);
+        if (i == nelems)
         {
-            printf ("rank: %d step:%d ... PASS\n", rank, step);
+            printf ("rank: %d step:%d ... PASS\n", rank, firststep+step);
         }
         else
         {
-            printf ("rank: %d step:%d ... ERROR: %d %d\n", rank, step, x[step*nelems + i], (int)(gnx*step + offset + i));
+            printf ("rank: %d step:%d ... ERROR: %d %d\n", rank, firststep+step, xs[i],
+                        patternValue(v.pattern, gnx, firststep + step, offset + i));
         }
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,238 @@
+/*
+ * Machine-readable benchmark results.
+ */
+
+#include "results.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <sys/time.h>
+
+PhaseStats phaseStats(std::vector<double> v)
+{
+    PhaseStats s = {0, 0, 0, 0, 0, 0, 0};
+    if (v.empty())
+        return s;
+
+    std::sort(v.begin(), v.end());
+    double sum = 0.0, sum2 = 0.0;
+    for (size_t i = 0; i < v.size(); i++)
+    {
+        sum += v[i];
+        sum2 += v[i] * v[i];
+    }
+    s.min = v.front();
+    s.max = v.back();
+    s.mean = sum / v.size();
+    s.stddev = sqrt(std::max(0.0, sum2 / v.size() - s.mean * s.mean));
+
+    // Nearest-rank percentiles
+    auto pct = [&](double p)
+    {
+        size_t k = (size_t) ceil(p / 100.0 * v.size());
+        return v[k > 0 ? k - 1 : 0];
+    };
+    s.p50 = pct(50);
+    s.p90 = pct(90);
+    s.p99 = pct(99);
+    return s;
+}
+
+double wallTime()
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec * 1e-6;
+}
+
+Results::Results(const char *program, MPI_Comm comm)
+    : program_(program), comm_(comm)
+{
+    MPI_Comm_rank(comm_, &rank_);
+    MPI_Comm_size(comm_, &nproc_);
+}
+
+void Results::setConfig(const char **help, const char *dump)
+{
+    // Defaults: "  -n, --len=LONG  array length  (default=`1000')"
+    for (int i = 0; help[i]; i++)
+    {
+        const char *opt = strstr(help[i], "--");
+        if (opt == NULL)
+            continue;
+        std::string name(opt + 2, strcspn(opt + 2, "= "));
+        if (name == "help" || name == "version")
+            continue;
+
+        std::string value;
+        const char *def = strstr(help[i], "(default=`");
+        if (def)
+        {
+            def += strlen("(default=`");
+            value.assign(def, strcspn(def, "'"));
+        }
+        else if (strstr(help[i], "(default=off)"))
+        {
+            value = "off";
+        }
+        addConfig(name, value);
+    }
+
+    // Given options: name="value" or a bare flag name
+    const char *line = dump;
+    while (line && *line)
+    {
+        size_t len = strcspn(line, "\n");
+        std::string entry(line, len);
+        size_t eq = entry.find('=');
+        if (eq == std::string::npos)
+            addConfig(entry, "on");
+        else
+            addConfig(entry.substr(0, eq), entry.substr(eq + 2, entry.size() - eq - 3));
+        line += len;
+        if (*line == '\n')
+            line++;
+    }
+}
+
+void Results::addConfig(const std::string &key, const std::string &value)
+{
+    for (size_t i = 0; i < config_.size(); i++)
+    {
+        if (config_[i].first == key)
+        {
+            config_[i].second = value;
+            return;
+        }
+    }
+    config_.push_back(std::make_pair(key, value));
+}
+
+void Results::gather(int step, const std::vector<std::string> &phases,
+                     const double *values, uint64_t bytes, uint64_t stored)
+{
+    int n = phases.size();
+    std::vector<double> all(rank_ == 0 ? n * nproc_ : 0);
+    MPI_Gather((void *) values, n, MPI_DOUBLE, all.data(), n, MPI_DOUBLE, 0, comm_);
+    if (rank_ != 0)
+        return;
+
+    Step s;
+    s.step = step;
+    s.bytes = bytes;
+    s.stored = stored ? stored : bytes;
+    s.phases = phases;
+    for (int i = 0; i < n; i++)
+    {
+        std::vector<double> v(nproc_);
+        for (int r = 0; r < nproc_; r++)
+            v[r] = all[r * n + i];
+        s.stats.push_back(phaseStats(v));
+    }
+    steps_.push_back(s);
+}
+
+// Phases ending in _mb are sizes, not times, and have no bandwidth
+static bool isSize(const std::string &phase)
+{
+    return phase.size() > 3 && phase.compare(phase.size() - 3, 3, "_mb") == 0;
+}
+
+static std::string jsonString(const std::string &s)
+{
+    std::string out = "\"";
+    for (size_t i = 0; i < s.size(); i++)
+    {
+        char c = s[i];
+        if (c == '"' || c == '\\')
+        {
+            out += '\\';
+            out += c;
+        }
+        else if ((unsigned char) c < 0x20)
+        {
+            char buf[8];
+            snprintf(buf, sizeof(buf), "\\u%04x", c);
+            out += buf;
+        }
+        else
+        {
+            out += c;
+        }
+    }
+    return out + "\"";
+}
+
+bool Results::writeJSON(FILE *fp) const
+{
+    fprintf(fp, "{\n  \"program\": %s,\n  \"nproc\": %d,\n  \"config\": {",
+            jsonString(program_).c_str(), nproc_);
+    for (size_t i = 0; i < config_.size(); i++)
+        fprintf(fp, "%s\n    %s: %s", i ? "," : "",
+                jsonString(config_[i].first).c_str(), jsonString(config_[i].second).c_str());
+    fprintf(fp, "\n  },\n  \"steps\": [");
+    for (size_t k = 0; k < steps_.size(); k++)
+    {
+        const Step &s = steps_[k];
+        fprintf(fp, "%s\n    {\"step\": %d, \"bytes\": %llu, \"stored\": %llu, \"phases\": {",
+                k ? "," : "", s.step, (unsigned long long) s.bytes,
+                (unsigned long long) s.stored);
+        for (size_t i = 0; i < s.phases.size(); i++)
+        {
+            const PhaseStats &p = s.stats[i];
+            double mbs = p.max > 0 && !isSize(s.phases[i]) ? s.bytes / p.max / 1024 / 1024 : 0.0;
+            fprintf(fp, "%s\n      %s: {\"min\": %.6f, \"mean\": %.6f, \"max\": %.6f, "
+                    "\"stddev\": %.6f, \"p50\": %.6f, \"p90\": %.6f, \"p99\": %.6f, "
+                    "\"MBps\": %.3f}",
+                    i ? "," : "", jsonString(s.phases[i]).c_str(),
+                    p.min, p.mean, p.max, p.stddev, p.p50, p.p90, p.p99, mbs);
+        }
+        fprintf(fp, "\n    }}");
+    }
+    fprintf(fp, "\n  ]\n}\n");
+    return !ferror(fp);
+}
+
+bool Results::writeCSV(FILE *fp) const
+{
+    for (size_t i = 0; i < config_.size(); i++)
+        fprintf(fp, "# %s=%s\n", config_[i].first.c_str(), config_[i].second.c_str());
+    fprintf(fp, "program,nproc,step,phase,bytes,stored,min,mean,max,stddev,p50,p90,p99,MBps\n");
+    for (size_t k = 0; k < steps_.size(); k++)
+    {
+        const Step &s = steps_[k];
+        for (size_t i = 0; i < s.phases.size(); i++)
+        {
+            const PhaseStats &p = s.stats[i];
+            double mbs = p.max > 0 && !isSize(s.phases[i]) ? s.bytes / p.max / 1024 / 1024 : 0.0;
+            fprintf(fp, "%s,%d,%d,%s,%llu,%llu,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.3f\n",
+                    program_.c_str(), nproc_, s.step, s.phases[i].c_str(),
+                    (unsigned long long) s.bytes, (unsigned long long) s.stored,
+                    p.min, p.mean, p.max, p.stddev, p.p50, p.p90, p.p99, mbs);
+        }
+    }
+    return !ferror(fp);
+}
+
+bool Results::write(const char *filename) const
+{
+    if (rank_ != 0)
+        return true;
+
+    FILE *fp = fopen(filename, "w");
+    if (fp == NULL)
+    {
+        printf("Cannot open results file %s\n", filename);
+        return false;
+    }
+
+    size_t len = strlen(filename);
+    bool ok;
+    if (len > 4 && strcmp(filename + len - 4, ".csv") == 0)
+        ok = writeCSV(fp);
+    else
+        ok = writeJSON(fp);
+    return fclose(fp) == 0 && ok;
+}
@@ -0,0 +1,70 @@
+/*
+ * Machine-readable benchmark results.
+ *
+ * Per-rank phase timings are gathered to rank 0 once per step, reduced to
+ * min/mean/max/stddev/percentiles, and written by rank 0 as a single JSON
+ * (or CSV, for a .csv file name) per run together with the configuration.
+ */
+
+#ifndef RESULTS_H
+#define RESULTS_H
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include <mpi.h>
+
+struct PhaseStats
+{
+    double min, mean, max, stddev;
+    double p50, p90, p99;
+};
+
+// Statistics over one value per rank
+PhaseStats phaseStats(std::vector<double> v);
+
+// Wall-clock seconds since the epoch. Unlike MPI_Wtime it compares between
+// jobs, as far as the clocks of their nodes are synchronized.
+double wallTime();
+
+class Results
+{
+public:
+    Results(const char *program, MPI_Comm comm);
+
+    // Run configuration from the gengetopt help lines (option names and
+    // defaults) and cmdline_parser_dump output (given options)
+    void setConfig(const char **help, const char *dump);
+    void addConfig(const std::string &key, const std::string &value);
+
+    // Collective: gather values[i] of phases[i] from all ranks. bytes is
+    // the total over all ranks moved in this step, used for bandwidth of
+    // the slowest rank in each phase. stored is the size of those bytes in
+    // storage when a transform changes it (rank 0 only, 0: same as bytes).
+    void gather(int step, const std::vector<std::string> &phases,
+                const double *values, uint64_t bytes, uint64_t stored = 0);
+
+    // Write the file on rank 0. Returns false on I/O error.
+    bool write(const char *filename) const;
+
+private:
+    struct Step
+    {
+        int step;
+        uint64_t bytes, stored;
+        std::vector<std::string> phases;
+        std::vector<PhaseStats> stats;
+    };
+
+    std::string program_;
+    MPI_Comm comm_;
+    int rank_, nproc_;
+    std::vector< std::pair<std::string, std::string> > config_;
+    std::vector<Step> steps_;
+
+    bool writeJSON(FILE *fp) const;
+    bool writeCSV(FILE *fp) const;
+};
+
+#endif /* RESULTS_H */
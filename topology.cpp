@@ -0,0 +1,232 @@
+/*
+ * Node topology of the job and aggregator placement.
+ */
+
+#include "topology.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+
+Topology::Topology(MPI_Comm comm, int ranksPerNode)
+    : comm_(comm), leaders_(MPI_COMM_NULL), emulated_(ranksPerNode > 0)
+{
+    int rank, nproc;
+    MPI_Comm_rank(comm_, &rank);
+    MPI_Comm_size(comm_, &nproc);
+    if (emulated_)
+        MPI_Comm_split(comm_, rank / ranksPerNode, rank, &node_);
+    else
+        MPI_Comm_split_type(comm_, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &node_);
+    MPI_Comm_rank(node_, &nodeRank_);
+    MPI_Comm_size(node_, &nodeSize_);
+    MPI_Comm_split(comm_, nodeRank_ == 0 ? 0 : MPI_UNDEFINED, rank, &leaders_);
+
+    // Nodes are numbered in the order of their first rank, so rank 0 leads
+    // node 0
+    int info[2] = {0, 0};
+    if (leaders_ != MPI_COMM_NULL)
+    {
+        MPI_Comm_rank(leaders_, &info[0]);
+        MPI_Comm_size(leaders_, &info[1]);
+    }
+    MPI_Bcast(info, 2, MPI_INT, 0, node_);
+    nodeIndex_ = info[0];
+    nnodes_ = info[1];
+
+    if (leaders_ != MPI_COMM_NULL)
+    {
+        char host[MPI_MAX_PROCESSOR_NAME];
+        int len;
+        memset(host, 0, sizeof(host));
+        MPI_Get_processor_name(host, &len);
+        // Emulated nodes share a host name
+        if (emulated_)
+            snprintf(host + len, sizeof(host) - len, "/%d", nodeIndex_);
+
+        std::vector<char> names(rank == 0 ? nnodes_ * MPI_MAX_PROCESSOR_NAME : 0);
+        MPI_Gather(host, MPI_MAX_PROCESSOR_NAME, MPI_CHAR, names.data(),
+                   MPI_MAX_PROCESSOR_NAME, MPI_CHAR, 0, leaders_);
+        for (int k = 0; k < nnodes_ && rank == 0; k++)
+            hosts_.push_back(&names[k * MPI_MAX_PROCESSOR_NAME]);
+    }
+    nodeOf_.resize(rank == 0 ? nproc : 0);
+    MPI_Gather(&nodeIndex_, 1, MPI_INT, nodeOf_.data(), 1, MPI_INT, 0, comm_);
+}
+
+void Topology::release()
+{
+    if (node_ != MPI_COMM_NULL)
+        MPI_Comm_free(&node_);
+    if (leaders_ != MPI_COMM_NULL)
+        MPI_Comm_free(&leaders_);
+}
+
+bool isPlacement(const std::string &placement)
+{
+    return placement == "rank" || placement == "spread" || placement == "pack" ||
+           access(placement.c_str(), R_OK) == 0;
+}
+
+// Group sizes of MPI_AGGREGATE: nproc / naggr ranks, one more in the first
+// nproc % naggr groups
+static std::vector<int> groupSizes(int nproc, int naggr)
+{
+    std::vector<int> sizes(naggr);
+    for (int g = 0; g < naggr; g++)
+        sizes[g] = nproc / naggr + (g < nproc % naggr ? 1 : 0);
+    return sizes;
+}
+
+std::vector<int> placeRanks(const std::string &placement, const std::vector<int> &nodeOf,
+        int nnodes, int naggr, std::string &err)
+{
+    const int nproc = nodeOf.size();
+    naggr = std::max(1, std::min(naggr, nproc));
+    std::vector<int> sizes = groupSizes(nproc, naggr);
+    std::vector< std::vector<int> > groups(naggr);
+
+    // Free ranks of each node, in rank order
+    std::vector< std::deque<int> > pool(nnodes);
+    for (int r = 0; r < nproc; r++)
+        pool[nodeOf[r]].push_back(r);
+    auto take = [&](int node)
+    {
+        int r = pool[node].front();
+        pool[node].pop_front();
+        return r;
+    };
+
+    if (placement == "rank")
+    {
+        for (int g = 0, r = 0; g < naggr; g++)
+            for (int i = 0; i < sizes[g]; i++)
+                groups[g].push_back(r++);
+    }
+    else if (placement == "spread")
+    {
+        for (int g = 0, k = 0; g < naggr; g++, k++)
+        {
+            while (pool[k % nnodes].empty())
+                k++;
+            groups[g].push_back(take(k % nnodes));
+        }
+        // Members from the aggregator's node first, then from any node
+        for (int g = 0; g < naggr; g++)
+        {
+            int node = nodeOf[groups[g][0]];
+            while ((int) groups[g].size() < sizes[g] && !pool[node].empty())
+                groups[g].push_back(take(node));
+        }
+        for (int g = 0, k = 0; g < naggr; g++)
+        {
+            while ((int) groups[g].size() < sizes[g])
+            {
+                while (pool[k].empty())
+                    k++;
+                groups[g].push_back(take(k));
+            }
+        }
+    }
+    else if (placement == "pack")
+    {
+        // The first naggr ranks in node order aggregate, the rest follow
+        std::vector<int> bynode;
+        for (int k = 0; k < nnodes; k++)
+            bynode.insert(bynode.end(), pool[k].begin(), pool[k].end());
+        size_t next = naggr;
+        for (int g = 0; g < naggr; g++)
+        {
+            groups[g].push_back(bynode[g]);
+            while ((int) groups[g].size() < sizes[g])
+                groups[g].push_back(bynode[next++]);
+        }
+    }
+    else
+    {
+        std::ifstream in(placement.c_str());
+        std::string line;
+        std::vector<int> seen(nproc, 0);
+        groups.clear();
+        while (std::getline(in, line))
+        {
+            line = line.substr(0, line.find('#'));
+            std::istringstream fields(line);
+            std::vector<int> group;
+            int r;
+            while (fields >> r)
+            {
+                if (r < 0 || r >= nproc || seen[r]++)
+                {
+                    err = placement + ": rank " + std::to_string(r) + " out of range or repeated";
+                    return std::vector<int>();
+                }
+                group.push_back(r);
+            }
+            if (!group.empty())
+                groups.push_back(group);
+        }
+        if (std::count(seen.begin(), seen.end(), 1) != nproc || (int) groups.size() != naggr)
+        {
+            err = placement + ": needs " + std::to_string(naggr) + " groups over all " +
+                  std::to_string(nproc) + " ranks";
+            return std::vector<int>();
+        }
+        // The larger groups come first
+        std::stable_sort(groups.begin(), groups.end(),
+                         [](const std::vector<int> &a, const std::vector<int> &b)
+        {
+            return a.size() > b.size();
+        });
+        for (int g = 0; g < naggr; g++)
+        {
+            if ((int) groups[g].size() != sizes[g])
+            {
+                err = placement + ": groups of " + std::to_string(nproc / naggr) +
+                      " or " + std::to_string(nproc / naggr + 1) + " ranks needed";
+                return std::vector<int>();
+            }
+        }
+    }
+
+    std::vector<int> order;
+    for (int g = 0; g < naggr; g++)
+        order.insert(order.end(), groups[g].begin(), groups[g].end());
+    return order;
+}
+
+MPI_Comm placementComm(MPI_Comm comm, const Topology &topo, const std::string &placement,
+        int naggr, int &maxpernode, std::string &err)
+{
+    int rank, nproc;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &nproc);
+
+    // Position of each rank in the new order; launch order on error
+    std::vector<int> key(rank == 0 ? nproc : 0);
+    maxpernode = 0;
+    if (rank == 0)
+    {
+        std::vector<int> order = placeRanks(placement, topo.nodeOf(), topo.nodes(), naggr, err);
+        if (!order.empty())
+        {
+            naggr = std::max(1, std::min(naggr, nproc));
+            std::vector<int> sizes = groupSizes(nproc, naggr), pernode(topo.nodes(), 0);
+            for (int g = 0, pos = 0; g < naggr; pos += sizes[g++])
+                pernode[topo.nodeOf()[order[pos]]]++;
+            maxpernode = *std::max_element(pernode.begin(), pernode.end());
+        }
+        for (int i = 0; i < nproc; i++)
+            key[order.empty() ? i : order[i]] = i;
+    }
+    int mykey;
+    MPI_Scatter(key.data(), 1, MPI_INT, &mykey, 1, MPI_INT, 0, comm);
+
+    MPI_Comm placed;
+    MPI_Comm_split(comm, 0, mykey, &placed);
+    return placed;
+}
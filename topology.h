@@ -0,0 +1,72 @@
+/*
+ * Node topology of the job: node-local and node-leader communicators,
+ * node names, and the placement of aggregators over nodes.
+ *
+ * Nodes are the shared-memory domains of the communicator, or groups of
+ * consecutive ranks to emulate several nodes on one. Only node leaders
+ * exchange host names; rank 0 keeps one name per node and the node of
+ * each rank.
+ */
+
+#ifndef TOPOLOGY_H
+#define TOPOLOGY_H
+
+#include <string>
+#include <vector>
+#include <mpi.h>
+
+class Topology
+{
+public:
+    // Collective. ranksPerNode > 0 groups that many consecutive ranks into
+    // a node instead of using MPI_COMM_TYPE_SHARED.
+    Topology(MPI_Comm comm, int ranksPerNode);
+
+    // Collective: frees the node communicators, before MPI_Finalize
+    void release();
+
+    MPI_Comm nodeComm() const { return node_; }
+    // The first rank of every node, MPI_COMM_NULL on the others
+    MPI_Comm leaderComm() const { return leaders_; }
+
+    int node() const { return nodeIndex_; }
+    int nodes() const { return nnodes_; }
+    int nodeRank() const { return nodeRank_; }
+    int nodeSize() const { return nodeSize_; }
+    bool emulated() const { return emulated_; }
+
+    // Rank 0 only: host of each node, node of each rank
+    const std::vector<std::string> &hosts() const { return hosts_; }
+    const std::vector<int> &nodeOf() const { return nodeOf_; }
+
+private:
+    MPI_Comm comm_, node_, leaders_;
+    int nodeIndex_, nnodes_, nodeRank_, nodeSize_;
+    bool emulated_;
+    std::vector<std::string> hosts_;
+    std::vector<int> nodeOf_;
+};
+
+// Aggregator placements:
+//   rank   - as launched: the first rank of each of the contiguous groups
+//            MPI_AGGREGATE forms aggregates
+//   spread - aggregators round-robin over the nodes, each with members
+//            from its own node first
+//   pack   - aggregators on as few nodes as possible
+//   FILE   - one line per aggregator: its rank, then its members' ranks
+bool isPlacement(const std::string &placement);
+
+// Rank 0: the ranks in the order to give to the write method so that it
+// aggregates by the placement with naggr aggregators. MPI_AGGREGATE makes
+// the first rank of each group an aggregator, with nproc / naggr ranks
+// per group and one more in the first nproc % naggr groups. Empty, with a
+// message in err, if a placement file does not fit.
+std::vector<int> placeRanks(const std::string &placement, const std::vector<int> &nodeOf,
+        int nnodes, int naggr, std::string &err);
+
+// Collective: comm with its ranks renumbered by placeRanks on rank 0, and
+// on rank 0 the largest number of aggregators on one node (0 on error)
+MPI_Comm placementComm(MPI_Comm comm, const Topology &topo, const std::string &placement,
+        int naggr, int &maxpernode, std::string &err);
+
+#endif /* TOPOLOGY_H */
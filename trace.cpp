@@ -0,0 +1,127 @@
+/*
+ * Per-rank timeline of benchmark events.
+ */
+
+#include "trace.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+Trace::Trace(MPI_Comm comm, bool enabled)
+    : comm_(comm), enabled_(enabled), offset_(0.0), maxoffset_(0.0),
+      main_(std::this_thread::get_id())
+{
+    MPI_Comm_rank(comm_, &rank_);
+    MPI_Comm_size(comm_, &nproc_);
+    if (enabled_)
+        syncClocks(10);
+}
+
+// Rank 0 exchanges a message with each rank in turn. The rank's clock is
+// read when it answers, halfway through the round trip as seen by rank 0;
+// the round with the shortest trip gives the offset.
+void Trace::syncClocks(int rounds)
+{
+    for (int r = 1; r < nproc_; r++)
+    {
+        if (rank_ == 0)
+        {
+            double best = 1e30, offset = 0.0;
+            for (int k = 0; k < rounds; k++)
+            {
+                double t0 = MPI_Wtime(), tr;
+                MPI_Send(&t0, 1, MPI_DOUBLE, r, 0, comm_);
+                MPI_Recv(&tr, 1, MPI_DOUBLE, r, 0, comm_, MPI_STATUS_IGNORE);
+                double t1 = MPI_Wtime();
+                if (t1 - t0 < best)
+                {
+                    best = t1 - t0;
+                    offset = tr - (t0 + t1) / 2;
+                }
+            }
+            MPI_Send(&offset, 1, MPI_DOUBLE, r, 0, comm_);
+            maxoffset_ = std::max(maxoffset_, fabs(offset));
+        }
+        else if (rank_ == r)
+        {
+            for (int k = 0; k < rounds; k++)
+            {
+                double t0;
+                MPI_Recv(&t0, 1, MPI_DOUBLE, 0, 0, comm_, MPI_STATUS_IGNORE);
+                double tr = MPI_Wtime();
+                MPI_Send(&tr, 1, MPI_DOUBLE, 0, 0, comm_);
+            }
+            MPI_Recv(&offset_, 1, MPI_DOUBLE, 0, 0, comm_, MPI_STATUS_IGNORE);
+        }
+    }
+}
+
+void Trace::span(const std::string &name, double begin, double end, int step)
+{
+    if (!enabled_)
+        return;
+
+    Event e;
+    e.begin = begin - offset_;
+    e.end = end - offset_;
+    e.step = step;
+    e.tid = std::this_thread::get_id() == main_ ? 0 : 1;
+    snprintf(e.name, sizeof(e.name), "%s", name.c_str());
+    std::lock_guard<std::mutex> guard(lock_);
+    events_.push_back(e);
+}
+
+bool Trace::write(const char *filename)
+{
+    if (!enabled_)
+        return true;
+
+    int bytes = events_.size() * sizeof(Event);
+    std::vector<int> counts(nproc_), displs(nproc_);
+    MPI_Gather(&bytes, 1, MPI_INT, counts.data(), 1, MPI_INT, 0, comm_);
+    int total = 0;
+    for (int r = 0; r < nproc_; r++)
+    {
+        displs[r] = total;
+        total += counts[r];
+    }
+    std::vector<Event> all(rank_ == 0 ? total / sizeof(Event) : 0);
+    MPI_Gatherv(events_.data(), bytes, MPI_BYTE, all.data(), counts.data(), displs.data(),
+                MPI_BYTE, 0, comm_);
+    events_.clear();
+    if (rank_ != 0)
+        return true;
+
+    FILE *fp = fopen(filename, "w");
+    if (fp == NULL)
+    {
+        printf("Cannot open trace file %s\n", filename);
+        return false;
+    }
+
+    // Microseconds from the first event
+    double t0 = 1e30;
+    for (size_t i = 0; i < all.size(); i++)
+        t0 = std::min(t0, all[i].begin);
+
+    fprintf(fp, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [");
+    for (int r = 0; r < nproc_; r++)
+        fprintf(fp, "%s\n{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": %d, "
+                "\"args\": {\"name\": \"rank %d\"}}", r ? "," : "", r, r);
+    size_t k = 0;
+    for (int r = 0; r < nproc_; r++)
+    {
+        for (int n = 0; n < counts[r] / (int) sizeof(Event); n++, k++)
+        {
+            const Event &e = all[k];
+            fprintf(fp, ",\n{\"name\": \"%s\", \"ph\": \"X\", \"pid\": %d, \"tid\": %d, "
+                    "\"ts\": %.3f, \"dur\": %.3f, \"args\": {\"step\": %d}}",
+                    e.name, r, e.tid, (e.begin - t0) * 1e6, (e.end - e.begin) * 1e6, e.step);
+        }
+    }
+    fprintf(fp, "\n]}\n");
+    bool ok = !ferror(fp);
+    return fclose(fp) == 0 && ok;
+}
@@ -0,0 +1,59 @@
+/*
+ * Per-rank timeline of benchmark events.
+ *
+ * Each rank records spans (name, begin, end, step) in its own MPI_Wtime,
+ * corrected by an offset to the clock of rank 0 that a ping-pong exchange
+ * estimates at start-up. Rank 0 gathers the events and writes them as a
+ * Chrome trace (JSON, opened by chrome://tracing or Perfetto) with one
+ * process per rank and one thread per recording thread.
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <mpi.h>
+
+class Trace
+{
+public:
+    // Collective. A disabled trace records nothing and skips the clock
+    // synchronization.
+    Trace(MPI_Comm comm, bool enabled);
+
+    bool enabled() const { return enabled_; }
+
+    // Record a span of this rank in local MPI_Wtime. Thread-safe; spans of
+    // the constructing thread go to thread 0, others to thread 1.
+    void span(const std::string &name, double begin, double end, int step = -1);
+
+    // Largest clock offset to rank 0 over ranks, in seconds (rank 0 only)
+    double maxOffset() const { return maxoffset_; }
+
+    // Collective: gather the events to rank 0, which writes the file.
+    // Events are cleared afterwards. Returns false on I/O error.
+    bool write(const char *filename);
+
+private:
+    struct Event
+    {
+        double begin, end;
+        int step, tid;
+        char name[32];
+    };
+
+    MPI_Comm comm_;
+    int rank_, nproc_;
+    bool enabled_;
+    double offset_, maxoffset_;
+    std::thread::id main_;
+    std::mutex lock_;
+    std::vector<Event> events_;
+
+    void syncClocks(int rounds);
+};
+
+#endif /* TRACE_H */
@@ -8,24 +8,100 @@
  */
 
 #include <iostream>
+#include <fstream>
+#include <sstream>
 #include <vector>
+#include <algorithm>
+#include <cmath>
 #include <unistd.h>
 #include <climits>
 #include <mpi.h>
 #include <adios.h>
+#include <adios_error.h>
 #include <string.h>
 #include <unistd.h>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
 #include "cmdline.h"
+#include "memutil.h"
+#include "fileutil.h"
+#include "results.h"
+#include "pattern.h"
+#include "trace.h"
+#include "hoststats.h"
+#include "drain.h"
+#include "compute.h"
+#include "topology.h"
 
 #define MAXTASKS 8192
-#define BLOCK_SIZE 1024*1024*512
+
+// One configuration of a parameter sweep
+struct SweepPoint
+{
+    unsigned long len;
+    std::string method;
+    std::string params;
+    int nvars;
+    int imbalance;
+    std::string placement;
+};
+
+// Distributions of block sizes over ranks
+enum Imbalance {IMBALANCE_UNIFORM, IMBALANCE_LINEAR, IMBALANCE_ZIPF,
+                IMBALANCE_HEAVY, IMBALANCE_ZERO};
+
+static const char *imbalanceNames[] = {"uniform", "linear", "zipf", "heavy", "zero"};
+
+// Types of the extra arrays
+struct VarType
+{
+    const char *name;
+    enum ADIOS_DATATYPES type;
+    int size;
+};
+
+static const VarType varTypes[] = {
+    {"byte", adios_byte, 1},
+    {"short", adios_short, 2},
+    {"int", adios_integer, 4},
+    {"long", adios_long, 8},
+    {"float", adios_real, 4},
+    {"double", adios_double, 8},
+    {"complex", adios_complex, 8},
+    {"dcomplex", adios_double_complex, 16},
+};
+
+// One entry of --type: an extra array type and its length (0: len)
+struct VarSpec
+{
+    const VarType *type;
+    unsigned long len;
+};
+
+std::vector<SweepPoint> readSweep(const char *filename, unsigned long len,
+        const char *method, const char *params, int nvars, int imbalance,
+        const char *placement, MPI_Comm comm);
+bool parseVarSpecs(const char *list, std::vector<VarSpec> &specs);
+void fillVar(std::vector<char> &buf, const VarSpec &spec, unsigned long len,
+        unsigned long glen, unsigned long offset, int pattern);
+void decompose(unsigned long len, bool strong, int nproc, int rank,
+        unsigned long &count, unsigned long &global, unsigned long &offset);
+int imbalanceByName(const std::string &name);
+double rankWeight(int imbalance, double skew, int rank, int nproc);
+void blockLayout(unsigned long len, bool strong, int imbalance, double skew, MPI_Comm comm,
+        unsigned long &count, unsigned long &global, unsigned long &offset);
+std::string sweepName(const char *name, size_t c, size_t n);
+std::string tuneParams(const char *base, int aggr, int ost);
+int paramValue(const std::string &params, const std::string &key, int dflt);
+std::vector< std::pair<int, int> > tuneRefine(const std::vector< std::pair<int, int> > &tried,
+        const std::vector<double> &bw, int nproc, int maxost);
 
 int main(int argc, char *argv[])
 {
     setlinebuf(stdout);
     int rank = 0, nproc = 1;
-    int namelength;
-    char host[MPI_MAX_PROCESSOR_NAME];
 
     gengetopt_args_info args_info;
     if (cmdline_parser (argc, argv, &args_info) != 0)
@@ -36,124 +112,1249 @@ int main(int argc, char *argv[])
         cmdline_parser_print_help();
         exit(1);
     }
-    const char *outputfile = args_info.inputs[0];
+
+    if (!isTouchPattern(args_info.touch_arg))
+    {
+        std::cout << "Unknown touch pattern: " << args_info.touch_arg << "\n";
+        exit(1);
+    }
+    const int pattern = patternByName(args_info.pattern_arg);
+    if (pattern < 0)
+    {
+        std::cout << "Unknown data pattern: " << args_info.pattern_arg << "\n";
+        exit(1);
+    }
+    const int fthreads = std::max(1, args_info.fill_threads_arg);
+    const bool durable = args_info.durable_flag;
+    // Strong scaling: lengths are global and split over the processes
+    const bool strong = args_info.global_len_given;
+    const unsigned long baselen = strong ? args_info.global_len_arg : args_info.len_arg;
+    const int imbalance = imbalanceByName(args_info.imbalance_arg);
+    if (imbalance < 0)
+    {
+        std::cout << "Unknown imbalance: " << args_info.imbalance_arg << "\n";
+        exit(1);
+    }
+    const double skew = args_info.skew_arg;
+    if (!isPlacement(args_info.placement_arg))
+    {
+        std::cout << "Unknown placement: " << args_info.placement_arg << "\n";
+        exit(1);
+    }
+    const uint64_t buffermb = std::max(0, args_info.buffer_mb_arg);
+    enum ADIOS_BUFFER_ALLOC_WHEN bufferalloc = ADIOS_BUFFER_ALLOC_UNKNOWN;
+    if (strcmp(args_info.buffer_alloc_arg, "now") == 0)
+        bufferalloc = ADIOS_BUFFER_ALLOC_NOW;
+    else if (strcmp(args_info.buffer_alloc_arg, "later") == 0)
+        bufferalloc = ADIOS_BUFFER_ALLOC_LATER;
+    else if (strcmp(args_info.buffer_alloc_arg, "default") != 0)
+    {
+        std::cout << "Unknown buffer allocation: " << args_info.buffer_alloc_arg << "\n";
+        exit(1);
+    }
+    // adios_allocate_buffer takes the size to allocate
+    if (bufferalloc != ADIOS_BUFFER_ALLOC_UNKNOWN && buffermb == 0)
+    {
+        std::cout << "--buffer-alloc needs a --buffer-mb size\n";
+        exit(1);
+    }
+    const int kernel = kernelByName(args_info.compute_arg);
+    if (kernel < 0)
+    {
+        std::cout << "Unknown compute kernel: " << args_info.compute_arg << "\n";
+        exit(1);
+    }
+    std::vector<VarSpec> varspecs;
+    if (!parseVarSpecs(args_info.type_arg, varspecs))
+    {
+        std::cout << "Invalid variable types: " << args_info.type_arg << "\n";
+        exit(1);
+    }
     
-    MPI_Init(&argc, &argv);
+    // In pipeline mode all ADIOS calls and collectives of the step loop
+    // move to the I/O thread, while the main thread generates data. Both
+    // threads still time their work with MPI_Wtime (and the halo kernel
+    // talks to other ranks), so the pipeline needs MPI_THREAD_MULTIPLE.
+    const int required = args_info.pipeline_arg >= 2 ? MPI_THREAD_MULTIPLE
+                                                      : MPI_THREAD_SERIALIZED;
+    int provided;
+    MPI_Init_thread(&argc, &argv, required, &provided);
     MPI_Comm comm = MPI_COMM_WORLD;
     MPI_Comm_rank(comm, &rank);
     MPI_Comm_size(comm, &nproc);
 
-    /* All tasks send their host name to task 0 */
-    char *hostmap = (char*) malloc(nproc * MPI_MAX_PROCESSOR_NAME);
-    MPI_Get_processor_name(host, &namelength);
-    MPI_Gather(&host, MPI_MAX_PROCESSOR_NAME, MPI_CHAR, hostmap,
-             MPI_MAX_PROCESSOR_NAME, MPI_CHAR, 0, MPI_COMM_WORLD);
+    // Node-local and node-leader communicators; rank 0 learns the host of
+    // each node and the node of each rank
+    Topology topo(comm, args_info.ranks_per_node_arg);
 
-    const unsigned long NX = args_info.len_arg;
     const int NSTEPS = args_info.nstep_arg;
-    const unsigned long gnx = NX * nproc;
-    const unsigned long offs = rank * NX;
+    const int NBUFS = (provided >= required) ? args_info.pipeline_arg : 0;
 
-    adios_init_noxml(comm);
+    // Configurations to run: the command line, the sweep file, or the
+    // candidates of the auto-tuner (num_aggregators, num_ost)
+    std::vector<SweepPoint> sweep;
+    std::vector< std::pair<int, int> > tuned;
+    const bool autotune = args_info.autotune_flag;
+    const int maxost = std::max(1, args_info.tune_max_ost_arg);
+    if (autotune && args_info.sweep_given)
+    {
+        if (rank == 0)
+            printf("--autotune and --sweep cannot be combined\n");
+        topo.release();
+        MPI_Finalize();
+        return 1;
+    }
+    if (autotune)
+    {
+        // Coarse grid: powers of 4 up to nproc aggregators (and nproc
+        // itself), each with powers of 4 up to maxost OSTs
+        std::vector<int> aggrs;
+        for (int a = 1; a < nproc; a *= 4)
+            aggrs.push_back(a);
+        aggrs.push_back(nproc);
+        for (size_t i = 0; i < aggrs.size(); i++)
+        {
+            int a = aggrs[i];
+            for (int o = 1; o <= std::min(a, maxost); o *= 4)
+                tuned.push_back(std::make_pair(a, o));
+        }
+        for (size_t i = 0; i < tuned.size(); i++)
+        {
+            SweepPoint p = {baselen, args_info.writemethod_arg,
+                            tuneParams(args_info.wparams_arg, tuned[i].first, tuned[i].second),
+                            args_info.nvars_arg, imbalance, args_info.placement_arg};
+            sweep.push_back(p);
+        }
+    }
+    else if (args_info.sweep_given)
+    {
+        sweep = readSweep(args_info.sweep_arg, baselen,
+                          args_info.writemethod_arg, args_info.wparams_arg,
+                          args_info.nvars_arg, imbalance, args_info.placement_arg, comm);
+        if (sweep.empty())
+        {
+            if (rank == 0)
+                printf("No configurations in sweep file %s\n", args_info.sweep_arg);
+            topo.release();
+            MPI_Finalize();
+            return 1;
+        }
+    }
+    else
+    {
+        SweepPoint p = {baselen,
+                        args_info.writemethod_arg, args_info.wparams_arg,
+                        args_info.nvars_arg, imbalance, args_info.placement_arg};
+        sweep.push_back(p);
+    }
+
+    // Imbalance lines for every point once one is imbalanced, so that the
+    // uniform points of a sweep give the balanced reference
+    bool imbalanced = false;
+    for (size_t c = 0; c < sweep.size(); c++)
+        imbalanced = imbalanced || sweep[c].imbalance != IMBALANCE_UNIFORM;
+    // Likewise placement lines once a point places its aggregators
+    bool placed = args_info.placement_given;
+    for (size_t c = 0; c < sweep.size(); c++)
+        placed = placed || sweep[c].placement != "rank";
 
-    int64_t       m_adios_group;
-    adios_declare_group (&m_adios_group, "writer", "", adios_stat_no);
-    adios_define_var (m_adios_group, "gnx", "", adios_unsigned_long, 0, 0, 0);
-    adios_define_var (m_adios_group, "offs", "", adios_unsigned_long, 0, 0, 0);
-    adios_define_var (m_adios_group, "nx", "", adios_unsigned_long, 0, 0, 0);
-    adios_define_var (m_adios_group, "x", "", adios_integer, "nx", "gnx", "offs");
-    adios_select_method (m_adios_group, args_info.writemethod_arg, args_info.wparams_arg, "");
+    adios_init_noxml(comm);
+    // ADIOS buffer: its maximum size and when it is allocated
+    if (buffermb > 0)
+        adios_set_max_buffer_size(buffermb);
+    // A no-op since ADIOS 1.10, which sizes its buffer at each open
+    if (bufferalloc != ADIOS_BUFFER_ALLOC_UNKNOWN)
+        adios_allocate_buffer(bufferalloc, buffermb);
+    // Peak memory per step where the kernel can reset the high-water mark
+    const bool steppeak = resetPeakResident();
+    Trace trace(comm, args_info.trace_given);
 
-    void* tmp = malloc(BLOCK_SIZE);
-    memset(tmp, '\0', BLOCK_SIZE);
+    // Ballast emulating the resident memory of the application, either a
+    // fixed size per process or a fraction of node memory shared by the
+    // processes of the node (the real node, even with --ranks-per-node)
+    MPI_Comm nodecomm;
+    int nodesize, noderank;
+    MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &nodecomm);
+    MPI_Comm_size(nodecomm, &nodesize);
+    MPI_Comm_rank(nodecomm, &noderank);
+    MPI_Comm_free(&nodecomm);
 
-    /*
-    int i=0;
-    char *buf[10];
-    while(i<10)
+    size_t ballast = (size_t) args_info.ballast_mb_arg * 1024 * 1024;
+    if (args_info.ballast_frac_arg > 0)
+        ballast = (size_t) (nodeMemory() * args_info.ballast_frac_arg / nodesize);
+    void* tmp = allocBallast(ballast, args_info.thp_flag);
+    if (ballast > 0 && tmp == NULL)
     {
-        buf[i] = (char*)malloc(BLOCK_SIZE);
-        if (buf[i] == NULL)
-            printf("Memory allocation failed");
-        memset(buf[i],'\0',BLOCK_SIZE);
-        i++;
+        printf("rank %d: ballast allocation of %zu bytes failed\n", rank, ballast);
+        MPI_Abort(comm, 1);
     }
-    */
-
-    std::vector<int> x(NX);
-    std::string mode = "w";
+    touchBallast(tmp, ballast, args_info.touch_arg, rank);
 
-    if (rank == 0)
+    // Compute phase between steps, and its rate with no I/O going on as
+    // the reference for the slowdown (slowest rank). Sleep has no rate.
+    Compute compute(kernel, (size_t) args_info.compute_mb_arg * 1024 * 1024,
+                    (size_t) args_info.halo_kb_arg * 1024, comm);
+    double refrate = 0.0;
+    if (kernel != KERNEL_SLEEP)
     {
-        printf("====== Info =======\n");
-        printf("%10s: %lu\n", "NX", NX);
-        printf("%10s: %d\n", "Total NPs", nproc);
-        printf("%10s: %.3f\n", "MBs/proc", (float) sizeof(int)*NX/1024/1024);
-        printf("%10s: %s\n", "Method", args_info.writemethod_arg);
-        printf("%10s: %s\n", "Params", args_info.wparams_arg);
-        for (int i=0; i<nproc; i++)
-            printf("%10s: %5d %s\n", "MAP", i, &hostmap[i*MPI_MAX_PROCESSOR_NAME]);
-        printf("===================\n\n");
-        printf(">>> %5s %5s %9s %12s %9s %12s %9s %12s\n",
-               "rank", "step", "t3-t0", "(MB/s)", "t3-t1", "(MB/s)", "t3-t2", "(MB/s)");
-        fflush(stdout);
+        refrate = compute.run(std::min(1.0, (double) args_info.sleep_arg));
+        MPI_Allreduce(MPI_IN_PLACE, &refrate, 1, MPI_DOUBLE, MPI_MIN, comm);
     }
-    MPI_Barrier(MPI_COMM_WORLD);
 
-    for (int step = 0; step < NSTEPS; step++)
+    // Bandwidth of each point for the tuner, from the slowest rank per step
+    std::vector<double> pointbw;
+    for (size_t c = 0; c < sweep.size(); c++)
     {
-        for (unsigned long i = 0; i < NX; i++)
+        // Each sweep point gets its own group, output file and results.
+        // Tuner points are always numbered since refinement adds more.
+        const size_t npoints = autotune ? std::max<size_t>(sweep.size(), 2) : sweep.size();
+        std::string group = (npoints > 1) ? "writer." + std::to_string(c) : "writer";
+        std::string outputname = sweepName(args_info.inputs[0], c, npoints);
+        const char *outputfile = outputname.c_str();
+
+        unsigned long NX, gnx, offs;
+        blockLayout(sweep[c].len, strong, sweep[c].imbalance, skew, comm, NX, gnx, offs);
+        unsigned long minnx, maxnx;
+        MPI_Allreduce(&NX, &minnx, 1, MPI_UNSIGNED_LONG, MPI_MIN, comm);
+        MPI_Allreduce(&NX, &maxnx, 1, MPI_UNSIGNED_LONG, MPI_MAX, comm);
+
+        int64_t       m_adios_group;
+        adios_declare_group (&m_adios_group, group.c_str(), "", adios_stat_no);
+        adios_define_var (m_adios_group, "gnx", "", adios_unsigned_long, 0, 0, 0);
+        adios_define_var (m_adios_group, "offs", "", adios_unsigned_long, 0, 0, 0);
+        adios_define_var (m_adios_group, "nx", "", adios_unsigned_long, 0, 0, 0);
+        int64_t xid = adios_define_var (m_adios_group, "x", "", adios_integer, "nx", "gnx", "offs");
+        // Wall-clock time each step is handed to ADIOS, for the latency of
+        // a reader following the output (reader --follow)
+        adios_define_var (m_adios_group, "tstep", "", adios_double, 0, 0, 0);
+        // Extra arrays v0..vN-1, cycling through the --type list, to put
+        // the metadata of many variables on open and close
+        const int nvars = sweep[c].nvars;
+        std::vector<std::string> vnames(nvars);
+        std::vector<int64_t> vids(nvars);
+        std::vector< std::vector<char> > vbufs(nvars);
+        uint64_t rankbytes = sizeof(int) * NX;
+        for (int v = 0; v < nvars; v++)
         {
-            x[i] = (step * NX * nproc + rank * NX + i) % INT_MAX;
+            const VarSpec &spec = varspecs[v % varspecs.size()];
+            unsigned long len, glen, voffs;
+            blockLayout(spec.len ? spec.len : sweep[c].len, strong, sweep[c].imbalance, skew,
+                        comm, len, glen, voffs);
+            vnames[v] = "v" + std::to_string(v);
+            vids[v] = adios_define_var (m_adios_group, vnames[v].c_str(), "", spec.type->type,
+                                        std::to_string(len).c_str(),
+                                        std::to_string(glen).c_str(),
+                                        std::to_string(voffs).c_str());
+            fillVar(vbufs[v], spec, len, glen, voffs, pattern);
+            rankbytes += vbufs[v].size();
         }
+        // Blocks differ by rank under strong scaling
+        uint64_t totalbytes;
+        MPI_Allreduce(&rankbytes, &totalbytes, 1, MPI_UINT64_T, MPI_SUM, comm);
 
-        int64_t f;
-        double t[4];
+        const bool transform = strlen(args_info.transform_arg) > 0;
+        if (transform)
+        {
+            adios_set_transform (xid, args_info.transform_arg);
+            for (int v = 0; v < nvars; v++)
+                adios_set_transform (vids[v], args_info.transform_arg);
+            adios_define_attribute (m_adios_group, "transform", "", adios_string,
+                                    args_info.transform_arg, "");
+        }
+        // Pattern of x, for the reader to verify it
+        adios_define_attribute (m_adios_group, "pattern", "", adios_string,
+                                patternName(pattern), "");
+        // Ranks reordered for the write method, so that the aggregators of
+        // MPI_AGGREGATE (the first rank of each group) sit where the
+        // placement wants them
+        const int naggr = std::max(1, std::min(nproc, paramValue(sweep[c].params, "num_aggregators", nproc)));
+        int maxpernode;
+        std::string placeerr;
+        MPI_Comm iocomm = placementComm(comm, topo, sweep[c].placement, naggr,
+                                        maxpernode, placeerr);
+        int iorank;
+        MPI_Comm_rank(iocomm, &iorank);
+        // One checksum of x per writer, for reader --checksum. The reader
+        // finds a writer's by the process id of its block, its rank in the
+        // communicator of the write.
+        if (args_info.checksum_flag)
+            adios_define_var (m_adios_group, "xsum", "", adios_unsigned_long, "1",
+                              std::to_string(nproc).c_str(), std::to_string(iorank).c_str());
+        adios_select_method (m_adios_group, sweep[c].method.c_str(), sweep[c].params.c_str(), "");
 
-        MPI_Barrier(comm);
-        t[0] = MPI_Wtime();
-        adios_open(&f, "writer", outputfile, mode.c_str(), comm);
-        t[1] = MPI_Wtime();
-        adios_write(f, "gnx", &gnx);
-        adios_write(f, "nx", &NX);
-        adios_write(f, "offs", &offs);
-        adios_write(f, "x", x.data());
-        t[2] = MPI_Wtime();
-        adios_close(f);
-        //sync();
-        t[3] = MPI_Wtime();
+        // Run configuration for the results file
+        Results results("writer", comm);
+        char *dump = NULL;
+        size_t dumplen = 0;
+        FILE *dumpfp = open_memstream(&dump, &dumplen);
+        cmdline_parser_dump(dumpfp, &args_info);
+        fclose(dumpfp);
+        results.setConfig(gengetopt_args_info_help, dump);
+        results.addConfig("file", outputfile);
+        // The point's length (per process, or the global one under strong
+        // scaling) and the global array it gave
+        results.addConfig("len", std::to_string(sweep[c].len));
+        results.addConfig("strong", strong ? "on" : "off");
+        if (strong)
+            results.addConfig("global-len", std::to_string(sweep[c].len));
+        results.addConfig("gnx", std::to_string(gnx));
+        results.addConfig("writemethod", sweep[c].method);
+        results.addConfig("wparams", sweep[c].params);
+        results.addConfig("nvars", std::to_string(nvars));
+        results.addConfig("imbalance", imbalanceNames[sweep[c].imbalance]);
+        results.addConfig("skew", std::to_string(skew));
+        results.addConfig("minnx", std::to_string(minnx));
+        results.addConfig("maxnx", std::to_string(maxnx));
+        free(dump);
+        HostStats hoststats(comm, topo);
 
-        double elap[3];
-        elap[0] = t[3] - t[0];
-        elap[1] = t[3] - t[1];
-        elap[2] = t[3] - t[2];
+        // Burst buffer: one thread per node copies each closed step to the
+        // final directory
+        const bool draining = args_info.drain_given;
+        Drain drain(outputname, draining ? args_info.drain_arg : "", draining && noderank == 0,
+                    args_info.append_flag);
 
-        printf(">>> %5d %5d %9.03f %12.03f %9.03f %12.03f %9.03f %12.03f\n",
-               rank, step,
-               elap[0], (float)sizeof(int) * x.size() / elap[0] / 1024 / 1024,
-               elap[1], (float)sizeof(int) * x.size() / elap[1] / 1024 / 1024,
-               elap[2], (float)sizeof(int) * x.size() / elap[2] / 1024 / 1024);
+        std::string mode = "w";
 
-        double melap[3];
-        MPI_Reduce(elap, melap, 3, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
         if (rank == 0)
         {
-
-            printf(">>> %5s %5d %9.03f %12.03f %9.03f %12.03f %9.03f %12.03f\n",
-                   "ALL", step,
-                   melap[0], (float)sizeof(int) * x.size() * nproc / melap[0] / 1024 / 1024,
-                   melap[1], (float)sizeof(int) * x.size() * nproc / melap[1] / 1024 / 1024,
-                   melap[2], (float)sizeof(int) * x.size() * nproc / melap[2] / 1024 / 1024);
+            printf("====== Info =======\n");
+            if (autotune)
+                printf("%10s: point %d, %d aggregators, %d OSTs\n", "Tune", (int) c + 1,
+                       tuned[c].first, tuned[c].second);
+            else if (sweep.size() > 1)
+                printf("%10s: %d of %d\n", "Sweep", (int) c + 1, (int) sweep.size());
+            printf("%10s: %lu\n", "NX", NX);
+            if (strong)
+                printf("%10s: %lu, split over processes (strong scaling)\n", "GNX", gnx);
+            if (sweep[c].imbalance != IMBALANCE_UNIFORM)
+                printf("%10s: %s, skew %g, nx %lu..%lu\n", "Imbalance",
+                       imbalanceNames[sweep[c].imbalance], skew, minnx, maxnx);
+            printf("%10s: %d\n", "Total NPs", nproc);
+            printf("%10s: %d%s\n", "Nodes", topo.nodes(),
+                   topo.emulated() ? ", emulated" : "");
+            if (placed && placeerr.empty())
+                printf("%10s: %s, %d aggregators, at most %d on a node\n", "Placement",
+                       sweep[c].placement.c_str(), naggr, maxpernode);
+            else if (placed)
+                printf("%10s: %s, using rank order\n", "Placement", placeerr.c_str());
+            printf("%10s: %.3f\n", "MBs/proc", (float) rankbytes/1024/1024);
+            if (nvars > 0)
+                printf("%10s: x + %d of %s\n", "Variables", nvars, args_info.type_arg);
+            printf("%10s: %s\n", "Output", outputfile);
+            printf("%10s: %s\n", "Method", sweep[c].method.c_str());
+            printf("%10s: %s\n", "Params", sweep[c].params.c_str());
+            printf("%10s: %s, %d fill threads\n", "Pattern", patternName(pattern), fthreads);
+            if (buffermb > 0)
+                printf("%10s: %lu MB max, allocated %s\n", "Buffer",
+                       (unsigned long) buffermb, args_info.buffer_alloc_arg);
+            printf("%10s: %s\n", "Peak RSS", steppeak ? "per step" : "whole run (no clear_refs)");
+            if (transform)
+                printf("%10s: %s\n", "Transform", args_info.transform_arg);
+            if (durable)
+                printf("%10s: fsync before stopping the clock\n", "Durable");
+            printf("%10s: %.3f MB/proc, %d procs/node, touch=%s%s\n", "Ballast",
+                   (float) ballast/1024/1024, nodesize, args_info.touch_arg,
+                   args_info.thp_flag ? ", THP" : "");
+            if (args_info.retouch_arg > 0)
+                printf("%10s: every %d steps\n", "Retouch", args_info.retouch_arg);
+            if (trace.enabled())
+                printf("%10s: %s, clock offsets up to %.1f us\n", "Trace",
+                       sweepName(args_info.trace_arg, c, npoints).c_str(), trace.maxOffset() * 1e6);
+            if (draining)
+                printf("%10s: to %s, one thread per node%s\n", "Drain", args_info.drain_arg,
+                       args_info.append_flag ? "" : ", steps wait for it (no --append)");
+            if (kernel != KERNEL_SLEEP)
+                printf("%10s: %s for %d s, reference %.3f %s\n", "Compute",
+                       kernelName(kernel), args_info.sleep_arg, refrate, kernelUnit(kernel));
+#ifdef ADIOS_TIMERS
+            printf("%10s: ADIOS timers in %s.timers.STEP.xml\n", "Close", outputfile);
+#else
+            printf("%10s: data and metadata estimated from min and rank0\n", "Close");
+#endif
+            if (NBUFS >= 2)
+                printf("%10s: %d buffers\n", "Pipeline", NBUFS);
+            else if (args_info.pipeline_arg >= 2)
+                printf("%10s: disabled (no MPI_THREAD_MULTIPLE)\n", "Pipeline");
+            // The host map does not change between sweep points
+            for (int i=0; i<nproc && c == 0; i++)
+                printf("%10s: %5d %s\n", "MAP", i, topo.hosts()[topo.nodeOf()[i]].c_str());
+            printf("===================\n\n");
+            printf(">>> %5s %5s %9s %12s %9s %12s %9s %12s\n",
+                   "rank", "step", "t3-t0", "(MB/s)", "t3-t1", "(MB/s)", "t3-t2", "(MB/s)");
             fflush(stdout);
         }
         MPI_Barrier(MPI_COMM_WORLD);
 
-        if (args_info.append_flag) mode = "a";
-        sleep(args_info.sleep_arg);
+        // Per step: data generation (the compute phase), the step time of
+        // the slowest rank (rank 0), and the time a drain was copying during
+        // the fill and write, and during the whole step with the pause
+        std::vector<double> filltime(NSTEPS, 0.0), steptime(NSTEPS, 0.0);
+        std::vector<double> drainio(NSTEPS, 0.0), drainstep(NSTEPS, 0.0);
+        double drainwait = 0.0;
+
+        auto fillStep = [&](std::vector<int> &x, int step)
+        {
+            double tf = MPI_Wtime();
+            fillPattern(x.data(), NX, pattern, gnx, step, offs, fthreads);
+            filltime[step] = MPI_Wtime() - tf;
+            trace.span("fill", tf, tf + filltime[step], step);
+        };
+
+        // Periodically touch the ballast again, as an application would
+        // sweep its own memory between output steps
+        auto retouch = [&](int step)
+        {
+            if (args_info.retouch_arg > 0 && step > 0 && step % args_info.retouch_arg == 0)
+            {
+                double tr = MPI_Wtime();
+                touchBallast(tmp, ballast, args_info.touch_arg, rank + step);
+                trace.span("retouch", tr, MPI_Wtime(), step);
+            }
+        };
+
+        // Compute phase, with the rate of its kernel
+        std::vector<double> rate(NSTEPS, 0.0);
+        auto pause = [&](int step)
+        {
+            double ts = MPI_Wtime();
+            rate[step] = compute.run(args_info.sleep_arg);
+            trace.span(kernelName(kernel), ts, MPI_Wtime(), step);
+        };
+
+        std::vector<std::string> phases = {"open", "write", "close", "total"};
+        if (durable)
+        {
+            phases.push_back("sync");
+            phases.push_back("durable");
+        }
+        // Results also keep the memory of each rank: its peak resident set
+        // in the step and the growth over the open, in MB
+        std::vector<std::string> resphases = phases;
+        resphases.push_back("peak_mb");
+        resphases.push_back("step_mb");
+        double pointtime = 0.0;
+
+        // One output step: open, write, close and report. Returns t3-t0,
+        // or t4-t0 with the sync of --durable.
+        auto writeStep = [&](std::vector<int> &x, int step)
+        {
+            int64_t f;
+            double t[5];
+            uint64_t xsum = 0;
+            if (args_info.checksum_flag)
+                xsum = patternChecksum(x.data(), NX, 1);
+
+            // Without --append the open truncates the files that the drain
+            // of the last step may still be copying, so the step waits
+            if (draining && mode == "w" && step > 0)
+            {
+                double tw = MPI_Wtime();
+                drain.finish();
+                MPI_Barrier(comm);
+                double tdone = MPI_Wtime();
+                drainwait += tdone - tw;
+                trace.span("drain wait", tw, tdone, step);
+            }
+
+            // Free memory on the tightest node when the step starts
+            long avail = memAvailable(), minavail;
+            MPI_Reduce(&avail, &minavail, 1, MPI_LONG, MPI_MIN, 0, MPI_COMM_WORLD);
+
+            // Output size before the step over all nodes, to measure what
+            // the transform stored. Only file methods leave something to
+            // measure.
+            const bool leader = topo.leaderComm() != MPI_COMM_NULL;
+            uint64_t before = 0;
+            if (transform && leader && mode == "a")
+                before = outputBytesAll(outputfile, topo.leaderComm());
+
+            // Each adios_write is an event of its own in the trace
+            auto write = [&](const std::string &name, void *data)
+            {
+                double tw = MPI_Wtime();
+                adios_write(f, name.c_str(), data);
+                trace.span("write " + name, tw, MPI_Wtime(), step);
+            };
+
+            // Memory of the step: resident set at the open and its peak
+            // up to the close, where the ADIOS buffer shows up
+            if (steppeak)
+                resetPeakResident();
+            long rss = residentSize();
+
+            double tb = MPI_Wtime();
+            MPI_Barrier(comm);
+            t[0] = MPI_Wtime();
+            trace.span("barrier", tb, t[0], step);
+            // Only errors of this step count
+            adios_errno = 0;
+            adios_open(&f, group.c_str(), outputfile, mode.c_str(), iocomm);
+            // With a buffer limit, tell ADIOS what the step needs, so that
+            // a step larger than the buffer is known up front
+            uint64_t groupsize = 0;
+            if (buffermb > 0)
+                adios_group_size(f, rankbytes + 6 * sizeof(uint64_t), &groupsize);
+#ifdef ADIOS_TIMERS
+            // ADIOS keeps the timers of the last closed step of the group,
+            // which the handle of the next step writes out. The dump is
+            // left out of the step's times.
+            if (step > 0)
+            {
+                double tt = MPI_Wtime();
+                adios_timing_write_xml(f, (std::string(outputfile) + ".timers." +
+                                           std::to_string(step - 1) + ".xml").c_str());
+                double tdump = MPI_Wtime() - tt;
+                trace.span("timers", tt, tt + tdump, step);
+                t[0] += tdump;
+            }
+#endif
+            t[1] = MPI_Wtime();
+            trace.span("open", t[0], t[1], step);
+            write("gnx", &gnx);
+            write("nx", &NX);
+            write("offs", &offs);
+            write("x", x.data());
+            for (int v = 0; v < nvars; v++)
+                write(vnames[v], vbufs[v].data());
+            if (args_info.checksum_flag)
+                write("xsum", &xsum);
+            double tstep = wallTime();
+            write("tstep", &tstep);
+            t[2] = MPI_Wtime();
+            adios_close(f);
+            t[3] = MPI_Wtime();
+            trace.span("close", t[2], t[3], step);
+            // A step that does not fit the buffer is flushed in parts
+            // during the writes, or fails with an overflow that ADIOS
+            // reports. A group size above the cap only suggests one.
+            int overflow[2] = {adios_errno == err_buffer_overflow,
+                               buffermb > 0 && groupsize > buffermb * 1024 * 1024};
+            long mem[2] = {peakResident(), peakResident() - rss}, mmem[2];
+            int noverflow[2];
+            MPI_Reduce(mem, mmem, 2, MPI_LONG, MPI_MAX, 0, MPI_COMM_WORLD);
+            MPI_Reduce(overflow, noverflow, 2, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+            // Up to here the data may only have reached the page cache
+            if (durable)
+            {
+                // Each node syncs the files it sees, which are its own
+                // subfiles on node-local storage. A step that is not on
+                // storage has no durable time.
+                std::string syncerr;
+                if (!syncOutput(outputfile, topo.nodeRank(), topo.nodeSize(), syncerr))
+                {
+                    printf("rank %d: cannot sync %s\n", rank, syncerr.c_str());
+                    MPI_Abort(comm, 1);
+                }
+                MPI_Barrier(comm);
+            }
+            t[4] = MPI_Wtime();
+            if (durable)
+                trace.span("sync", t[3], t[4], step);
+
+            double elap[3];
+            elap[0] = t[3] - t[0];
+            elap[1] = t[3] - t[1];
+            elap[2] = t[3] - t[2];
+
+            if (!args_info.quiet_flag)
+                printf(">>> %5d %5d %9.03f %12.03f %9.03f %12.03f %9.03f %12.03f\n",
+                       rank, step,
+                       elap[0], (float) rankbytes / elap[0] / 1024 / 1024,
+                       elap[1], (float) rankbytes / elap[1] / 1024 / 1024,
+                       elap[2], (float) rankbytes / elap[2] / 1024 / 1024);
+
+            uint64_t stored = 0;
+            double xform = t[2] - t[1], mxform;
+            if (transform)
+            {
+                MPI_Barrier(comm);
+                if (leader)
+                    stored = outputBytesAll(outputfile, topo.leaderComm()) - before;
+                MPI_Reduce(&xform, &mxform, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+            }
+
+            double phase[6] = {t[1] - t[0], t[2] - t[1], t[3] - t[2], t[3] - t[0],
+                               t[4] - t[3], t[4] - t[0]};
+            std::vector<double> resphase(phase, phase + phases.size());
+            resphase.push_back(mem[0] / 1024.0);
+            resphase.push_back(mem[1] / 1024.0);
+            results.gather(step, resphases, resphase.data(), totalbytes, stored);
+            if (args_info.stragglers_flag)
+                hoststats.add(phases, phase, rankbytes);
+
+            double melap[3];
+            MPI_Reduce(elap, melap, 3, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+            // Slowest rank in open, copy into the ADIOS buffer, close, sync
+            // and the whole durable step, and the fastest rank in close
+            double oc[5] = {t[1] - t[0], t[2] - t[1], t[3] - t[2], t[4] - t[3], t[4] - t[0]}, moc[5];
+            MPI_Reduce(oc, moc, 5, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+            double minclose;
+            MPI_Reduce(&oc[2], &minclose, 1, MPI_DOUBLE, MPI_MIN, 0, MPI_COMM_WORLD);
+            // Step and close time summed over ranks and the fastest step,
+            // for the spread and the time ranks wait on the slowest
+            double tc[2] = {elap[0], oc[2]}, stc[2], minstep;
+            MPI_Reduce(tc, stc, 2, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+            MPI_Reduce(&elap[0], &minstep, 1, MPI_DOUBLE, MPI_MIN, 0, MPI_COMM_WORLD);
+            if (rank == 0)
+            {
+                steptime[step] = durable ? moc[4] : melap[0];
+                pointtime += steptime[step];
+            }
+            if (rank == 0)
+            {
+
+                printf(">>> %5s %5d %9.03f %12.03f %9.03f %12.03f %9.03f %12.03f\n",
+                       "ALL", step,
+                       melap[0], (float) totalbytes / melap[0] / 1024 / 1024,
+                       melap[1], (float) totalbytes / melap[1] / 1024 / 1024,
+                       melap[2], (float) totalbytes / melap[2] / 1024 / 1024);
+                // Free memory, the largest peak resident set of a rank, its
+                // growth over the step, the ranks ADIOS reported an
+                // overflow on and those whose step exceeded the cap
+                printf(">>> %5s %5d %9s %12.03f %9s %12.03f %9s %12.03f %9s %12d %9s %12d\n",
+                       "MEM", step, "avail(MB)", (float) minavail/1024,
+                       "peak(MB)", (float) mmem[0]/1024, "step(MB)", (float) mmem[1]/1024,
+                       "overflow", noverflow[0], "over-size", noverflow[1]);
+                // Stored size and ratio of the transformed step, the write
+                // phase that ran the transform, and the bandwidth of the
+                // stored bytes (the ALL line is the effective, raw one)
+                if (transform)
+                    printf(">>> %5s %5d %9s %12.03f %9s %12.03f %9s %12.03f %9s %12.03f\n",
+                           "XFRM", step, "stored(MB)", (float) stored/1024/1024,
+                           "ratio", stored ? (float) totalbytes / stored : 0.0,
+                           "xform(s)", mxform,
+                           "phys(MB/s)", (float) stored / melap[0] / 1024 / 1024);
+                // Open and close of the slowest rank against the variable
+                // count, where metadata dominates once arrays are small
+                if (nvars > 0)
+                    printf(">>> %5s %5d %9s %12d %9s %12.03f %9s %12.03f %9s %12.03f\n",
+                           "VARS", step, "nvars", nvars + 1, "open(s)", moc[0],
+                           "close(s)", moc[2], "ms/var", moc[2] * 1000 / (nvars + 1));
+                // Where the step went: the copy into the ADIOS buffer, then
+                // the close writing data and metadata. The fastest close is
+                // about the local data write; rank 0 also gathers and writes
+                // the metadata, which the slowest ranks wait for. Both are
+                // estimates; ADIOS_TIMERS builds dump ADIOS's own timers.
+                printf(">>> %5s %5d %9s %12.03f %9s %12.03f %9s %12.03f %9s %12.03f\n",
+                       "CLOSE", step, "copy(s)", moc[1], "close(s)", moc[2],
+                       "min(s)", minclose, "rank0(s)", t[3] - t[2]);
+                // Uneven blocks: largest block against the mean, spread of
+                // the step over ranks, and the mean time a rank waits for
+                // the slowest in the step and in the close, where
+                // aggregators wait for their largest senders
+                if (imbalanced)
+                    printf(">>> %5s %5d %9s %12.03f %9s %12.03f %9s %12.03f %9s %12.03f\n",
+                           "IMBAL", step, "max/mean", (double) maxnx * nproc / gnx,
+                           "spread(s)", melap[0] - minstep,
+                           "idle(s)", melap[0] - stc[0] / nproc,
+                           "cl-idle", moc[2] - stc[1] / nproc);
+                // Buffered against durable bandwidth of the same step
+                if (durable)
+                    printf(">>> %5s %5d %9s %12.03f %9s %12.03f %9s %12.03f %9s %12.03f\n",
+                           "SYNC", step, "sync(s)", moc[3], "durable(s)", moc[4],
+                           "(MB/s)", (float) totalbytes / moc[4] / 1024 / 1024,
+                           "buffered", (float) totalbytes / melap[0] / 1024 / 1024);
+                fflush(stdout);
+            }
+            MPI_Barrier(MPI_COMM_WORLD);
+
+            if (args_info.append_flag) mode = "a";
+            return durable ? t[4] - t[0] : elap[0];
+        };
+
+        if (NBUFS < 2)
+        {
+            std::vector<int> x(NX);
+            for (int step = 0; step < NSTEPS; step++)
+            {
+                retouch(step);
+                double busy = drain.busyTime();
+                fillStep(x, step);
+                writeStep(x, step);
+                drainio[step] = drain.busyTime() - busy;
+                drain.push(step);
+                pause(step);
+                drainstep[step] = drain.busyTime() - busy;
+            }
+        }
+        else
+        {
+            // Pipelined steps: the main thread fills a free buffer and goes on
+            // to the next step while the I/O thread writes the filled ones
+            std::vector< std::vector<int> > bufs(NBUFS, std::vector<int>(NX));
+            std::deque<int> freebufs, filled;
+            for (int i = 0; i < NBUFS; i++)
+                freebufs.push_back(i);
+            std::mutex lock;
+            std::condition_variable cond;
+            std::vector<double> iotime(NSTEPS), waittime(NSTEPS);
+
+            std::thread io([&]()
+            {
+                for (int step = 0; step < NSTEPS; step++)
+                {
+                    int b;
+                    {
+                        std::unique_lock<std::mutex> guard(lock);
+                        cond.wait(guard, [&]{ return !filled.empty(); });
+                        b = filled.front();
+                        filled.pop_front();
+                    }
+                    iotime[step] = writeStep(bufs[b], step);
+                    drain.push(step);
+                    {
+                        std::lock_guard<std::mutex> guard(lock);
+                        freebufs.push_back(b);
+                    }
+                    cond.notify_all();
+                }
+            });
+
+            for (int step = 0; step < NSTEPS; step++)
+            {
+                // Visible I/O cost: time blocked on a buffer still being written
+                double tw = MPI_Wtime();
+                int b;
+                {
+                    std::unique_lock<std::mutex> guard(lock);
+                    cond.wait(guard, [&]{ return !freebufs.empty(); });
+                    b = freebufs.front();
+                    freebufs.pop_front();
+                }
+                waittime[step] = MPI_Wtime() - tw;
+                trace.span("wait", tw, tw + waittime[step], step);
+
+                // The I/O thread writes while this one fills and pauses
+                retouch(step);
+                double busy = drain.busyTime();
+                fillStep(bufs[b], step);
+                drainio[step] = drain.busyTime() - busy;
+                {
+                    std::lock_guard<std::mutex> guard(lock);
+                    filled.push_back(b);
+                }
+                cond.notify_all();
+                pause(step);
+                drainstep[step] = drain.busyTime() - busy;
+            }
+            double tw = MPI_Wtime();
+            io.join();
+            double tdrain = MPI_Wtime() - tw;
+
+            // Per-step I/O time against the part of it the main thread saw.
+            // The wait before step s is caused by the write of step s-NBUFS.
+            std::vector<double> visible(NSTEPS, 0.0);
+            for (int step = 0; step < NSTEPS; step++)
+            {
+                if (step + NBUFS < NSTEPS)
+                    visible[step] = waittime[step + NBUFS];
+            }
+            if (NSTEPS > 0)
+                visible[NSTEPS - 1] += tdrain;
+
+            std::vector<double> miotime(NSTEPS), mvisible(NSTEPS);
+            MPI_Reduce(iotime.data(), miotime.data(), NSTEPS, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+            MPI_Reduce(visible.data(), mvisible.data(), NSTEPS, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+            if (rank == 0)
+            {
+                double sum[2] = {0.0, 0.0};
+                printf("\n>>> %5s %5s %9s %9s %9s\n", "", "step", "io", "visible", "hidden");
+                for (int step = 0; step < NSTEPS; step++)
+                {
+                    double hidden = std::max(0.0, miotime[step] - mvisible[step]);
+                    printf(">>> %5s %5d %9.03f %9.03f %9.03f\n",
+                           "PIPE", step, miotime[step], mvisible[step], hidden);
+                    sum[0] += miotime[step];
+                    sum[1] += mvisible[step];
+                }
+                printf(">>> %5s %5s %9.03f %9.03f %9.03f\n",
+                       "PIPE", "ALL", sum[0], sum[1], std::max(0.0, sum[0] - sum[1]));
+                fflush(stdout);
+            }
+        }
+
+        if (kernel != KERNEL_SLEEP && args_info.sleep_arg > 0)
+        {
+            // Kernel rate after each step against the reference, slowest
+            // rank: the slowdown the I/O still in flight causes
+            std::vector<double> mrate(NSTEPS);
+            MPI_Reduce(rate.data(), mrate.data(), NSTEPS, MPI_DOUBLE, MPI_MIN, 0, MPI_COMM_WORLD);
+            if (rank == 0)
+            {
+                printf("\n");
+                double sum = 0.0;
+                for (int step = 0; step < NSTEPS; step++)
+                {
+                    printf(">>> %5s %5d %9s %12.03f %9s %12.03f %9s %12.03f\n",
+                           "COMP", step, kernelUnit(kernel), mrate[step], "ref", refrate,
+                           "slowdown", mrate[step] > 0 ? refrate / mrate[step] : 0.0);
+                    sum += mrate[step];
+                }
+                double mean = NSTEPS > 0 ? sum / NSTEPS : 0.0;
+                printf(">>> %5s %5s %9s %12.03f %9s %12.03f %9s %12.03f\n",
+                       "COMP", "ALL", kernelUnit(kernel), mean, "ref", refrate,
+                       "slowdown", mean > 0 ? refrate / mean : 0.0);
+                fflush(stdout);
+            }
+        }
+
+        if (draining)
+        {
+            // Drain left once the last step is written, then per step the
+            // bytes copied, copy time, steps queued ahead, the time the
+            // drain overlapped the step, and the step times with and
+            // without a drain copying during the fill and write
+            double tt = MPI_Wtime();
+            drain.finish();
+            MPI_Barrier(comm);
+            double tail = MPI_Wtime() - tt;
+
+            std::vector<uint64_t> dbytes(NSTEPS, 0), mdbytes(NSTEPS);
+            std::vector<double> dtime(NSTEPS, 0.0), mdtime(NSTEPS), mfill(NSTEPS);
+            std::vector<double> mio(NSTEPS), mstep(NSTEPS);
+            std::vector<int> dbacklog(NSTEPS, 0), mdbacklog(NSTEPS);
+            std::vector<Drain::Step> dsteps = drain.steps();
+            for (size_t i = 0; i < dsteps.size(); i++)
+            {
+                dbytes[dsteps[i].step] = dsteps[i].bytes;
+                dtime[dsteps[i].step] = dsteps[i].seconds;
+                dbacklog[dsteps[i].step] = dsteps[i].backlog;
+            }
+            int dok = drain.ok(), mdok;
+            MPI_Reduce(dbytes.data(), mdbytes.data(), NSTEPS, MPI_UINT64_T, MPI_SUM, 0, MPI_COMM_WORLD);
+            MPI_Reduce(dtime.data(), mdtime.data(), NSTEPS, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+            MPI_Reduce(dbacklog.data(), mdbacklog.data(), NSTEPS, MPI_INT, MPI_MAX, 0, MPI_COMM_WORLD);
+            MPI_Reduce(drainio.data(), mio.data(), NSTEPS, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+            MPI_Reduce(drainstep.data(), mstep.data(), NSTEPS, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+            MPI_Reduce(filltime.data(), mfill.data(), NSTEPS, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+            MPI_Reduce(&dok, &mdok, 1, MPI_INT, MPI_MIN, 0, MPI_COMM_WORLD);
+            double mwait;
+            MPI_Reduce(&drainwait, &mwait, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+            if (rank == 0)
+            {
+                printf("\n");
+                double sum[2] = {0.0, 0.0};
+                int count[2] = {0, 0};
+                for (int step = 0; step < NSTEPS; step++)
+                {
+                    printf(">>> %5s %5d %9s %12.03f %9s %12.03f %9s %12.03f %9s %12d %9s %12.03f\n",
+                           "DRAIN", step, "MB", (float) mdbytes[step]/1024/1024,
+                           "drain(s)", mdtime[step],
+                           "(MB/s)", mdtime[step] > 0 ? (float) mdbytes[step] / mdtime[step] / 1024 / 1024 : 0.0,
+                           "backlog", mdbacklog[step], "overlap", mstep[step]);
+                    int busy = mio[step] > 0;
+                    sum[busy] += mfill[step] + steptime[step];
+                    count[busy]++;
+                }
+                // Compute and write time of a step while a drain runs
+                // against without
+                double idle = count[0] ? sum[0] / count[0] : 0.0;
+                double busy = count[1] ? sum[1] / count[1] : 0.0;
+                printf(">>> %5s %5s %9s %12.03f %9s %12.03f %9s %12.03f %9s %12.03f\n",
+                       "DRAIN", "ALL", "tail(s)", tail, "idle(s)", idle, "busy(s)", busy,
+                       "slowdown", idle > 0 && busy > 0 ? busy / idle : 0.0);
+                // Time steps waited for the drain before truncating its files
+                if (!args_info.append_flag)
+                    printf(">>> %5s %5s %9s %12.03f\n", "DRAIN", "WAIT", "wait(s)", mwait);
+                if (!mdok)
+                    printf("Drain to %s failed on some node\n", args_info.drain_arg);
+                fflush(stdout);
+            }
+        }
+        if (placed && rank == 0)
+        {
+            // Bandwidth of this placement for the aggregator count
+            printf("\n>>> %5s %-8s %9s %5d %9s %5d %9s %12.03f\n", "PLACE",
+                   sweep[c].placement.c_str(), "aggr", naggr, "max/node", maxpernode,
+                   "(MB/s)", pointtime > 0 ? (float) totalbytes * NSTEPS / pointtime / 1024 / 1024 : 0.0);
+            fflush(stdout);
+        }
+        MPI_Comm_free(&iocomm);
+        if (args_info.stragglers_flag)
+            hoststats.report();
+        if (args_info.results_given)
+            results.write(sweepName(args_info.results_arg, c, npoints).c_str());
+        if (args_info.trace_given)
+            trace.write(sweepName(args_info.trace_arg, c, npoints).c_str());
+
+        if (autotune)
+        {
+            MPI_Bcast(&pointtime, 1, MPI_DOUBLE, 0, comm);
+            pointbw.push_back(pointtime > 0 ? (double) totalbytes * NSTEPS / pointtime / 1024 / 1024 : 0.0);
+
+            // Once the queued points are done, refine around the best so far
+            if (c + 1 == sweep.size())
+            {
+                std::vector< std::pair<int, int> > next = tuneRefine(tuned, pointbw, nproc, maxost);
+                for (size_t i = 0; i < next.size(); i++)
+                {
+                    tuned.push_back(next[i]);
+                    SweepPoint p = {sweep[c].len, sweep[c].method,
+                                    tuneParams(args_info.wparams_arg, next[i].first, next[i].second),
+                                    sweep[c].nvars, sweep[c].imbalance, sweep[c].placement};
+                    sweep.push_back(p);
+                }
+            }
+        }
+    }
+
+    if (autotune && rank == 0)
+    {
+        // Measured curve by aggregator count, then the winner as a
+        // ready-to-use --wparams string
+        std::vector<size_t> order(tuned.size());
+        for (size_t i = 0; i < order.size(); i++)
+            order[i] = i;
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b)
+        {
+            return tuned[a] < tuned[b];
+        });
+        size_t best = std::max_element(pointbw.begin(), pointbw.end()) - pointbw.begin();
+        printf("\n>>> %5s %5s %5s %12s\n", "", "aggr", "ost", "(MB/s)");
+        for (size_t i = 0; i < order.size(); i++)
+            printf(">>> %5s %5d %5d %12.03f%s\n", "TUNE", tuned[order[i]].first,
+                   tuned[order[i]].second, pointbw[order[i]], order[i] == best ? " *" : "");
+        printf("\nBest: %.3f MB/s with\n--wparams=\"%s\"\n", pointbw[best], sweep[best].params.c_str());
+        fflush(stdout);
     }
 
     MPI_Barrier(comm);
+    free(tmp);
+    compute.release();
+    topo.release();
     adios_finalize(rank);
     MPI_Finalize();
     return 0;
 }
+
+// Read a sweep file on rank 0 and share it with all ranks. Each line is
+//   LEN [METHOD [PARAMS [NVARS [IMBALANCE [PLACEMENT]]]]]
+// where "-" or a missing field takes the command line value, and a field
+// may list alternatives separated by '|'. A line expands to all
+// combinations of its alternatives. '#' starts a comment. Returns no
+// points on an unknown imbalance, or on a placement that is neither a
+// known one nor a readable file.
+std::vector<SweepPoint> readSweep(const char *filename, unsigned long len,
+        const char *method, const char *params, int nvars, int imbalance,
+        const char *placement, MPI_Comm comm)
+{
+    int rank;
+    MPI_Comm_rank(comm, &rank);
+
+    std::string text;
+    long size = 0;
+    if (rank == 0)
+    {
+        std::ifstream in(filename);
+        if (in)
+        {
+            std::stringstream ss;
+            ss << in.rdbuf();
+            text = ss.str();
+        }
+        else
+        {
+            printf("Cannot open sweep file %s\n", filename);
+        }
+        size = text.size();
+    }
+    MPI_Bcast(&size, 1, MPI_LONG, 0, comm);
+    text.resize(size);
+    MPI_Bcast(&text[0], size, MPI_CHAR, 0, comm);
+
+    auto split = [](const std::string &s, const std::string &dflt)
+    {
+        std::vector<std::string> v;
+        if (s.empty() || s == "-")
+        {
+            v.push_back(dflt);
+            return v;
+        }
+        size_t pos = 0, bar;
+        while ((bar = s.find('|', pos)) != std::string::npos)
+        {
+            v.push_back(s.substr(pos, bar - pos));
+            pos = bar + 1;
+        }
+        v.push_back(s.substr(pos));
+        return v;
+    };
+
+    std::vector<SweepPoint> sweep;
+    std::istringstream lines(text);
+    std::string line;
+    while (std::getline(lines, line))
+    {
+        line = line.substr(0, line.find('#'));
+        std::istringstream fields(line);
+        std::string f[6];
+        if (!(fields >> f[0]))
+            continue;
+        fields >> f[1] >> f[2] >> f[3] >> f[4] >> f[5];
+
+        std::vector<std::string> lens = split(f[0], std::to_string(len));
+        std::vector<std::string> methods = split(f[1], method);
+        std::vector<std::string> plist = split(f[2], params);
+        std::vector<std::string> vlist = split(f[3], std::to_string(nvars));
+        std::vector<std::string> ilist = split(f[4], imbalanceNames[imbalance]);
+        std::vector<std::string> plclist = split(f[5], placement);
+        for (size_t m = 0; m < ilist.size(); m++)
+        {
+            if (imbalanceByName(ilist[m]) < 0)
+            {
+                if (rank == 0)
+                    printf("Unknown imbalance in sweep file: %s\n", ilist[m].c_str());
+                return std::vector<SweepPoint>();
+            }
+        }
+        for (size_t m = 0; m < plclist.size(); m++)
+        {
+            if (!isPlacement(plclist[m]))
+            {
+                if (rank == 0)
+                    printf("Unknown placement in sweep file: %s\n", plclist[m].c_str());
+                return std::vector<SweepPoint>();
+            }
+        }
+        for (size_t i = 0; i < lens.size(); i++)
+            for (size_t j = 0; j < methods.size(); j++)
+                for (size_t k = 0; k < plist.size(); k++)
+                    for (size_t l = 0; l < vlist.size(); l++)
+                        for (size_t m = 0; m < ilist.size(); m++)
+                            for (size_t n = 0; n < plclist.size(); n++)
+                            {
+                                SweepPoint p = {strtoul(lens[i].c_str(), NULL, 0), methods[j],
+                                                plist[k], atoi(vlist[l].c_str()),
+                                                imbalanceByName(ilist[m]), plclist[n]};
+                                sweep.push_back(p);
+                            }
+    }
+    return sweep;
+}
+
+// File name of sweep point c out of n: writer.bp -> writer.<c>.bp
+std::string sweepName(const char *name, size_t c, size_t n)
+{
+    std::string s = name;
+    if (n <= 1)
+        return s;
+
+    size_t slash = s.find_last_of('/');
+    size_t dot = s.find_last_of('.');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+        return s + "." + std::to_string(c);
+    return s.substr(0, dot) + "." + std::to_string(c) + s.substr(dot);
+}
+
+
+// Parse "TYPE[:LEN],..." into specs. False on an unknown type.
+bool parseVarSpecs(const char *list, std::vector<VarSpec> &specs)
+{
+    std::istringstream in(list);
+    std::string item;
+    while (std::getline(in, item, ','))
+    {
+        size_t colon = item.find(':');
+        std::string name = item.substr(0, colon);
+        VarSpec spec = {NULL, 0};
+        for (size_t i = 0; i < sizeof(varTypes) / sizeof(varTypes[0]); i++)
+            if (name == varTypes[i].name)
+                spec.type = &varTypes[i];
+        if (spec.type == NULL)
+            return false;
+        if (colon != std::string::npos)
+            spec.len = strtoul(item.c_str() + colon + 1, NULL, 0);
+        specs.push_back(spec);
+    }
+    return !specs.empty();
+}
+
+template <typename T>
+static void convertVar(const std::vector<int> &src, std::vector<char> &buf, int comps)
+{
+    T *dst = (T *) buf.data();
+    for (size_t i = 0; i < src.size(); i++)
+        for (int k = 0; k < comps; k++)
+            dst[i * comps + k] = (T) src[i];
+}
+
+// Block of rank in a 1D array. Weak scaling: len per process. Strong
+// scaling: len in total, split evenly with the remainder on the low ranks.
+void decompose(unsigned long len, bool strong, int nproc, int rank,
+        unsigned long &count, unsigned long &global, unsigned long &offset)
+{
+    if (!strong)
+    {
+        count = len;
+        global = len * nproc;
+        offset = len * rank;
+        return;
+    }
+    unsigned long base = len / nproc, rest = len % nproc;
+    count = base + ((unsigned long) rank < rest ? 1 : 0);
+    global = len;
+    offset = base * rank + std::min((unsigned long) rank, rest);
+}
+
+int imbalanceByName(const std::string &name)
+{
+    for (size_t i = 0; i < sizeof(imbalanceNames) / sizeof(imbalanceNames[0]); i++)
+        if (name == imbalanceNames[i])
+            return i;
+    return -1;
+}
+
+// Relative block size of rank:
+//   uniform - all equal
+//   linear  - growing with rank, the last one 1+skew times the first
+//   zipf    - 1/(rank+1)^skew
+//   heavy   - every 8th rank 1+skew times the others
+//   zero    - every 4th rank writes nothing, the others equal
+double rankWeight(int imbalance, double skew, int rank, int nproc)
+{
+    switch (imbalance)
+    {
+    case IMBALANCE_LINEAR:
+        return 1.0 + (nproc > 1 ? skew * rank / (nproc - 1) : 0.0);
+    case IMBALANCE_ZIPF:
+        return 1.0 / pow(rank + 1, skew);
+    case IMBALANCE_HEAVY:
+        return rank % 8 == 0 ? 1.0 + skew : 1.0;
+    case IMBALANCE_ZERO:
+        return rank % 4 == 3 ? 0.0 : 1.0;
+    default:
+        return 1.0;
+    }
+}
+
+// Block of the calling rank in a 1D array of len per process, or len in
+// total under strong scaling. Other than uniform blocks are sized by rank
+// weight: a block runs between the floors of the total scaled by the
+// weight prefix sums before and after the rank, so that the blocks add up
+// to the total. Offsets and the global length are summed over the
+// resulting counts.
+void blockLayout(unsigned long len, bool strong, int imbalance, double skew, MPI_Comm comm,
+        unsigned long &count, unsigned long &global, unsigned long &offset)
+{
+    int rank, nproc;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &nproc);
+    if (imbalance == IMBALANCE_UNIFORM)
+    {
+        decompose(len, strong, nproc, rank, count, global, offset);
+        return;
+    }
+
+    const unsigned long total = strong ? len : len * nproc;
+    double weight = rankWeight(imbalance, skew, rank, nproc), prefix = 0.0, wsum;
+    MPI_Exscan(&weight, &prefix, 1, MPI_DOUBLE, MPI_SUM, comm);
+    if (rank == 0)
+        prefix = 0.0;
+    MPI_Allreduce(&weight, &wsum, 1, MPI_DOUBLE, MPI_SUM, comm);
+    unsigned long lo = std::min(total, (unsigned long) floor(total * (prefix / wsum)));
+    unsigned long hi = rank == nproc - 1 ? total :
+                       std::min(total, (unsigned long) floor(total * ((prefix + weight) / wsum)));
+    count = hi > lo ? hi - lo : 0;
+    offset = 0;
+    MPI_Exscan(&count, &offset, 1, MPI_UNSIGNED_LONG, MPI_SUM, comm);
+    if (rank == 0)
+        offset = 0;
+    MPI_Allreduce(&count, &global, 1, MPI_UNSIGNED_LONG, MPI_SUM, comm);
+}
+
+// Contents of an extra array: the first step of the data pattern for a
+// block of len at offset of a glen array, converted to its type. Written
+// unchanged every step.
+void fillVar(std::vector<char> &buf, const VarSpec &spec, unsigned long len,
+        unsigned long glen, unsigned long offset, int pattern)
+{
+    std::vector<int> values(len);
+    fillPattern(values.data(), len, pattern, glen, 0, offset, 1);
+    buf.resize(len * spec.type->size);
+    switch (spec.type->type)
+    {
+    case adios_byte:
+        convertVar<int8_t>(values, buf, 1);
+        break;
+    case adios_short:
+        convertVar<int16_t>(values, buf, 1);
+        break;
+    case adios_long:
+        convertVar<int64_t>(values, buf, 1);
+        break;
+    case adios_real:
+        convertVar<float>(values, buf, 1);
+        break;
+    case adios_double:
+        convertVar<double>(values, buf, 1);
+        break;
+    case adios_complex:
+        convertVar<float>(values, buf, 2);
+        break;
+    case adios_double_complex:
+        convertVar<double>(values, buf, 2);
+        break;
+    default:
+        convertVar<int>(values, buf, 1);
+        break;
+    }
+}
+
+// Method parameters of a tuner point: base without its own aggregator
+// and OST settings, plus those of the point
+std::string tuneParams(const char *base, int aggr, int ost)
+{
+    std::string params;
+    std::istringstream in(base);
+    std::string item;
+    while (std::getline(in, item, ';'))
+    {
+        std::string key = item.substr(0, item.find('='));
+        if (item.empty() || key == "num_aggregators" || key == "num_ost")
+            continue;
+        params += item + ";";
+    }
+    return params + "num_aggregators=" + std::to_string(aggr) + ";num_ost=" + std::to_string(ost);
+}
+
+// Integer value of key in method parameters "k1=v1;k2=v2", dflt if absent
+int paramValue(const std::string &params, const std::string &key, int dflt)
+{
+    std::istringstream in(params);
+    std::string item;
+    while (std::getline(in, item, ';'))
+    {
+        size_t eq = item.find('=');
+        if (eq != std::string::npos && item.substr(0, eq) == key)
+            return atoi(item.c_str() + eq + 1);
+    }
+    return dflt;
+}
+
+// Untried neighbours of the best point so far: half and double the
+// aggregators or the OSTs, with 1 <= OSTs <= min(aggregators, maxost).
+// Empty when the best point has no untried neighbour left.
+std::vector< std::pair<int, int> > tuneRefine(const std::vector< std::pair<int, int> > &tried,
+        const std::vector<double> &bw, int nproc, int maxost)
+{
+    size_t best = std::max_element(bw.begin(), bw.end()) - bw.begin();
+    int a = tried[best].first, o = tried[best].second;
+    std::pair<int, int> cand[4] = {
+        std::make_pair(std::max(1, a / 2), o),
+        std::make_pair(std::min(nproc, a * 2), o),
+        std::make_pair(a, std::max(1, o / 2)),
+        std::make_pair(a, o * 2),
+    };
+
+    std::vector< std::pair<int, int> > next;
+    for (int i = 0; i < 4; i++)
+    {
+        std::pair<int, int> p = cand[i];
+        p.second = std::min(p.second, std::min(p.first, maxost));
+        if (std::find(tried.begin(), tried.end(), p) == tried.end() &&
+            std::find(next.begin(), next.end(), p) == next.end())
+            next.push_back(p);
+    }
+    return next;
+}